@@ -7,13 +7,26 @@
 
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <cmath>
 #include <memory>
 #include <random>
 #include <algorithm>
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <cstdlib>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 constexpr float PI = 3.14159265f;
 constexpr int WINDOW_WIDTH = 800;
@@ -27,18 +40,59 @@ float mapToRange(float rotation)
     return rotation;
 }
 
+// PCG32: small, fast and seedable. One generator per thread (threadRng), so
+// a seed passed on the command line replays the same spawns and wander jitter
+// and no two threads ever share generator state.
+class Rng {
+public:
+    using result_type = std::uint32_t;
+
+    explicit Rng(std::uint64_t seedValue = 0x853c49e6748fea9bULL) { seed(seedValue); }
+
+    void seed(std::uint64_t seedValue, std::uint64_t stream = 0xda3e39cb94b95bdbULL)
+    {
+        state = 0;
+        inc = (stream << 1) | 1u;
+        next();
+        state += seedValue;
+        next();
+    }
+
+    std::uint32_t next()
+    {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        std::uint32_t rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    float uniform() { return (next() >> 8) * (1.f / 16777216.f); } // [0, 1)
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xffffffffu; }
+    result_type operator()() { return next(); }
+
+private:
+    std::uint64_t state;
+    std::uint64_t inc;
+};
+
+Rng &threadRng()
+{
+    thread_local Rng rng((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}());
+    return rng;
+}
+
 float randomBinomial()
 {
-    static std::mt19937 gen(std::random_device{}());
-    static std::uniform_real_distribution<float> dis(0.f, 1.f);
-    return dis(gen) - dis(gen);
+    Rng &rng = threadRng();
+    return rng.uniform() - rng.uniform();
 }
 
 float randomFloat(float a, float b)
 {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_real_distribution<float> dis(a, b);
-    return dis(gen);
+    return a + (b - a) * threadRng().uniform();
 }
 
 // ---------------- data ----------------
@@ -54,43 +108,91 @@ struct SteeringOutput {
     float angular{0.f};
 };
 
+// ---------------- fixed timestep ----------------
+// advance() takes the real frame time and returns how many ticks of length dt
+// to simulate; alpha() is where rendering sits between the last two ticks. A
+// frame needing more than maxSubsteps ticks drops the backlog, so a hitch slows
+// the simulation down instead of taking one huge step.
+struct FixedTimestep {
+    float dt;
+    int maxSubsteps;
+    float accumulator = 0.f;
+
+    explicit FixedTimestep(float hz = 60.f, int maxSteps = 5) : dt(1.f / hz), maxSubsteps(maxSteps) {}
+
+    int advance(float frameTime) {
+        accumulator += frameTime;
+        int steps = 0;
+        while (accumulator >= dt && steps < maxSubsteps) { accumulator -= dt; ++steps; }
+        if (accumulator >= dt) accumulator = std::fmod(accumulator, dt);
+        return steps;
+    }
+    float alpha() const { return accumulator / dt; }
+};
+
+// Render pose between the previous and the current tick. Jumps over half the
+// window (screen wrap, resets) show the newer state instead of sweeping across.
+Kinematic interpolate(const Kinematic &from, const Kinematic &to, float alpha) {
+    Kinematic k = to;
+    sf::Vector2f d = to.position - from.position;
+    if (std::abs(d.x) > WINDOW_WIDTH / 2.f || std::abs(d.y) > WINDOW_HEIGHT / 2.f) return k;
+    k.position = from.position + d * alpha;
+    k.orientation = mapToRange(from.orientation + mapToRange(to.orientation - from.orientation) * alpha);
+    return k;
+}
+
 // ---------------- breadcrumbs ----------------
+// Fixed-capacity ring of the last maxCrumbs drops, drawn as one triangle list
+// (an octagon per crumb) whose alpha fades from the oldest crumb to the newest.
 class Breadcrumb {
-    std::queue<sf::Vector2f> q;
+    std::vector<sf::Vector2f> ring;
+    int head = 0;  // oldest crumb
+    int count = 0;
     int maxCrumbs;
     int dropInterval;
     int counter;
     sf::Color color;
+    sf::VertexArray mesh{sf::PrimitiveType::Triangles};
 public:
+    static constexpr int DOT_VERTICES = 24; // 8 triangles
+
     Breadcrumb(int maxCrumbs_=30, int dropInterval_=5, sf::Color c=sf::Color::Blue)
-        : maxCrumbs(maxCrumbs_), dropInterval(dropInterval_), counter(0), color(c) {}
+        : ring(std::max(0, maxCrumbs_)), maxCrumbs(maxCrumbs_), dropInterval(dropInterval_), counter(0), color(c) {}
 
     void update(const sf::Vector2f &pos) {
         if (++counter >= dropInterval) {
             counter = 0;
-            q.push(pos);
-            if ((int)q.size() > maxCrumbs) q.pop();
+            if (maxCrumbs <= 0) return;
+            if (count < maxCrumbs) ring[(head + count++) % maxCrumbs] = pos;
+            else { ring[head] = pos; head = (head + 1) % maxCrumbs; }
         }
     }
 
     void draw(sf::RenderWindow &win) {
-        std::queue<sf::Vector2f> temp = q;
+        if (count == 0) return;
+        static const sf::Vector2f octagon[8] = {{1.f, 0.f}, {0.7071068f, 0.7071068f}, {0.f, 1.f}, {-0.7071068f, 0.7071068f},
+                                                {-1.f, 0.f}, {-0.7071068f, -0.7071068f}, {0.f, -1.f}, {0.7071068f, -0.7071068f}};
+        const float radius = 3.f;
+        mesh.resize(static_cast<std::size_t>(count) * DOT_VERTICES);
         float alpha = 50.f;
         float inc = 200.f / std::max(1, maxCrumbs);
-        while (!temp.empty()) {
-            sf::CircleShape c(3.f);
-            c.setPosition(temp.front() - sf::Vector2f(3.f,3.f));
+        std::size_t v = 0;
+        for (int i = 0; i < count; ++i) {
+            sf::Vector2f center = ring[(head + i) % maxCrumbs];
             sf::Color col = color;
             col.a = static_cast<std::uint8_t>(std::min(255.f, alpha));
-            c.setFillColor(col);
-            win.draw(c);
-            temp.pop();
+            for (int k = 0; k < 8; ++k) {
+                mesh[v++] = sf::Vertex{center, col};
+                mesh[v++] = sf::Vertex{center + octagon[k] * radius, col};
+                mesh[v++] = sf::Vertex{center + octagon[(k + 1) % 8] * radius, col};
+            }
             alpha += inc;
         }
+        win.draw(mesh);
     }
 
     void clear() {
-        while (!q.empty()) q.pop();
+        head = count = 0;
         counter = 0;
     }
 };
@@ -370,19 +472,87 @@ public:
     }
 };
 
+// ---------------- spatial hash ----------------
+// Uniform grid over the window for neighbour queries. rebuild() counting-sorts
+// item indices by cell once per frame, so a query only walks the cells that
+// overlap its radius instead of the whole flock. With the cell size set to the
+// largest query radius that is at most 3x3 cells.
+class SpatialHashGrid {
+    float cellSize;
+    int cols, rows;
+    std::vector<int> cellStart; // items of cell c are items[cellStart[c] .. cellStart[c+1])
+    std::vector<int> items;
+    std::vector<int> cellOf;
+    std::vector<int> cursor;
+
+    int cellX(float x) const { return std::clamp(static_cast<int>(x / cellSize), 0, cols - 1); }
+    int cellY(float y) const { return std::clamp(static_cast<int>(y / cellSize), 0, rows - 1); }
+public:
+    explicit SpatialHashGrid(float cell = 100.f) { setCellSize(cell); }
+
+    // Positions outside the window are clamped into the border cells
+    void setCellSize(float cell) {
+        cellSize = std::max(1.f, cell);
+        cols = std::max(1, static_cast<int>(std::ceil(WINDOW_WIDTH / cellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(WINDOW_HEIGHT / cellSize)));
+        cellStart.assign(cols * rows + 1, 0);
+        items.clear();
+    }
+
+    // pos(i) -> sf::Vector2f for i in [0, n); indices stay in ascending order within a cell
+    template <class PosFn>
+    void rebuild(int n, PosFn &&pos) {
+        cellOf.resize(n);
+        cellStart.assign(cols * rows + 1, 0);
+        for (int i = 0; i < n; ++i) {
+            sf::Vector2f p = pos(i);
+            cellOf[i] = cellY(p.y) * cols + cellX(p.x);
+            ++cellStart[cellOf[i] + 1];
+        }
+        for (int c = 0; c < cols * rows; ++c) cellStart[c + 1] += cellStart[c];
+        cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        items.resize(n);
+        for (int i = 0; i < n; ++i) items[cursor[cellOf[i]]++] = i;
+    }
+
+    int numCells() const { return cols * rows; }
+
+    template <class Fn>
+    void forEachInCell(int c, Fn &&fn) const {
+        for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) fn(items[k]);
+    }
+
+    // Calls fn(i) for every item in a cell overlapping the square [p - radius, p + radius].
+    // These are candidates only, callers still test the real distance.
+    template <class Fn>
+    void forEachNear(sf::Vector2f p, float radius, Fn &&fn) const {
+        int x0 = cellX(p.x - radius), x1 = cellX(p.x + radius);
+        int y0 = cellY(p.y - radius), y1 = cellY(p.y + radius);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                int c = y * cols + x;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) fn(items[k]);
+            }
+        }
+    }
+};
+
 // ---------------- flocking behaviors ----------------
+// Each takes the shared flock list; with a grid (rebuilt over the same list every
+// frame) only nearby boids are visited, otherwise the whole flock is scanned.
 class Separation : public SteeringBehavior {
     float threshold;
     float decayCoefficient;
     float maxAcceleration;
     std::vector<Kinematic*> *boids;
+    const SpatialHashGrid *grid;
 public:
-    Separation(std::vector<Kinematic*> *b, float thresh=100.f, float decay=5000.f, float maxA=100.f)
-        : threshold(thresh), decayCoefficient(decay), maxAcceleration(maxA), boids(b) {}
+    Separation(std::vector<Kinematic*> *b, float thresh=100.f, float decay=5000.f, float maxA=100.f, const SpatialHashGrid *g=nullptr)
+        : threshold(thresh), decayCoefficient(decay), maxAcceleration(maxA), boids(b), grid(g) {}
     SteeringOutput calculateSteering(const Kinematic &c, const Kinematic & /*t*/) override {
         SteeringOutput out;
-        for (auto b : *boids) {
-            if (b->position == c.position) continue;
+        auto visit = [&](const Kinematic *b) {
+            if (b->position == c.position) return;
             sf::Vector2f direction = c.position - b->position;
             float dist = std::sqrt(direction.x*direction.x + direction.y*direction.y);
             if (dist < threshold && dist > 0.f) {
@@ -390,7 +560,9 @@ public:
                 direction = (direction / dist) * strength;
                 out.linear += direction;
             }
-        }
+        };
+        if (grid) grid->forEachNear(c.position, threshold, [&](int i) { visit((*boids)[i]); });
+        else for (auto b : *boids) visit(b);
         float mag = std::sqrt(out.linear.x*out.linear.x + out.linear.y*out.linear.y);
         if (mag > maxAcceleration) out.linear = (out.linear / mag) * maxAcceleration;
         return out;
@@ -401,19 +573,22 @@ class Cohesion : public SteeringBehavior {
     float neighborhoodRadius;
     float maxAcceleration;
     std::vector<Kinematic*> *boids;
+    const SpatialHashGrid *grid;
     Arrive arrive;
 public:
-    Cohesion(std::vector<Kinematic*> *b, float radius=150.f, float maxA=10.f)
-        : neighborhoodRadius(radius), maxAcceleration(maxA), boids(b), arrive(maxA, 100.f, 10.f, 50.f) {}
+    Cohesion(std::vector<Kinematic*> *b, float radius=150.f, float maxA=10.f, const SpatialHashGrid *g=nullptr)
+        : neighborhoodRadius(radius), maxAcceleration(maxA), boids(b), grid(g), arrive(maxA, 100.f, 10.f, 50.f) {}
     SteeringOutput calculateSteering(const Kinematic &c, const Kinematic & /*t*/) override {
         sf::Vector2f center(0.f, 0.f);
         int count = 0;
-        for (auto b : *boids) {
-            if (b->position == c.position) continue;
+        auto visit = [&](const Kinematic *b) {
+            if (b->position == c.position) return;
             sf::Vector2f dir = b->position - c.position;
             float dist = std::sqrt(dir.x*dir.x + dir.y*dir.y);
             if (dist < neighborhoodRadius) { center += b->position; ++count; }
-        }
+        };
+        if (grid) grid->forEachNear(c.position, neighborhoodRadius, [&](int i) { visit((*boids)[i]); });
+        else for (auto b : *boids) visit(b);
         if (count == 0) return {};
         center /= static_cast<float>(count);
         Kinematic target; target.position = center;
@@ -425,19 +600,22 @@ class Alignment : public SteeringBehavior {
     float neighborhoodRadius;
     float maxAcceleration;
     std::vector<Kinematic*> *boids;
+    const SpatialHashGrid *grid;
     VelocityMatching velocityMatch;
 public:
-    Alignment(std::vector<Kinematic*> *b, float radius=100.f, float maxA=50.f)
-        : neighborhoodRadius(radius), maxAcceleration(maxA), boids(b), velocityMatch(maxA) {}
+    Alignment(std::vector<Kinematic*> *b, float radius=100.f, float maxA=50.f, const SpatialHashGrid *g=nullptr)
+        : neighborhoodRadius(radius), maxAcceleration(maxA), boids(b), grid(g), velocityMatch(maxA) {}
     SteeringOutput calculateSteering(const Kinematic &c, const Kinematic & /*t*/) override {
         sf::Vector2f avg(0.f, 0.f);
         int count = 0;
-        for (auto b : *boids) {
-            if (b->position == c.position) continue;
+        auto visit = [&](const Kinematic *b) {
+            if (b->position == c.position) return;
             sf::Vector2f dir = b->position - c.position;
             float dist = std::sqrt(dir.x*dir.x + dir.y*dir.y);
             if (dist < neighborhoodRadius) { avg += b->velocity; ++count; }
-        }
+        };
+        if (grid) grid->forEachNear(c.position, neighborhoodRadius, [&](int i) { visit((*boids)[i]); });
+        else for (auto b : *boids) visit(b);
         if (count == 0) return {};
         avg /= static_cast<float>(count);
         Kinematic target; target.velocity = avg;
@@ -468,12 +646,364 @@ public:
     }
 };
 
+// Tuning shared by the blended flock and FlockingSteering (defaults are the Case 4 setup)
+struct FlockingParams {
+    float separationRadius = 40.f, separationDecay = 5000.f, separationMaxAccel = 250.f, separationWeight = 5.f;
+    float cohesionRadius = 100.f, cohesionMaxAccel = 80.f, cohesionWeight = 0.7f;
+    float alignmentRadius = 80.f, alignmentMaxAccel = 100.f, alignmentWeight = 0.7f;
+    float maxAcceleration = 200.f, maxAngular = 5.f; // BlendedSteering limits
+    float largestRadius() const { return std::max({separationRadius, cohesionRadius, alignmentRadius}); }
+};
+
+// Separation + Cohesion + Alignment blended in a single neighbour pass: one
+// distance per neighbour instead of three, and no virtual calls per behavior.
+// Neighbours are accumulated in the same order and with the same float ops as
+// the separate behaviors, so the result matches the BlendedSteering version.
+class FlockingSteering : public SteeringBehavior {
+    FlockingParams params;
+    std::vector<Kinematic*> *boids;
+    const SpatialHashGrid *grid;
+    Arrive arrive;
+    VelocityMatching velocityMatch;
+public:
+    FlockingSteering(std::vector<Kinematic*> *b, const FlockingParams &p = {}, const SpatialHashGrid *g = nullptr)
+        : params(p), boids(b), grid(g), arrive(p.cohesionMaxAccel, 100.f, 10.f, 50.f), velocityMatch(p.alignmentMaxAccel) {}
+    const FlockingParams &getParams() const { return params; }
+
+    SteeringOutput calculateSteering(const Kinematic &c, const Kinematic & /*t*/) override {
+        return steer(c, [&](auto &&visit) {
+            if (grid) grid->forEachNear(c.position, params.largestRadius(), [&](int i) { visit((*boids)[i]->position, (*boids)[i]->velocity); });
+            else for (auto b : *boids) visit(b->position, b->velocity);
+        });
+    }
+
+    // The kernel itself, for flocks not stored as Kinematics: neighbours(visit)
+    // must call visit(position, velocity) for every candidate neighbour of c
+    template <class Neighbours>
+    SteeringOutput steer(const Kinematic &c, Neighbours &&neighbours) {
+        sf::Vector2f separation(0.f, 0.f), center(0.f, 0.f), avgVelocity(0.f, 0.f);
+        int cohesionCount = 0, alignmentCount = 0;
+        neighbours([&](sf::Vector2f position, sf::Vector2f velocity) {
+            if (position == c.position) return;
+            sf::Vector2f direction = c.position - position;
+            float dist = std::sqrt(direction.x*direction.x + direction.y*direction.y);
+            if (dist < params.separationRadius && dist > 0.f) {
+                float strength = std::min(params.separationDecay / (dist*dist), params.separationMaxAccel);
+                separation += (direction / dist) * strength;
+            }
+            if (dist < params.cohesionRadius) { center += position; ++cohesionCount; }
+            if (dist < params.alignmentRadius) { avgVelocity += velocity; ++alignmentCount; }
+        });
+
+        float mag = std::sqrt(separation.x*separation.x + separation.y*separation.y);
+        if (mag > params.separationMaxAccel) separation = (separation / mag) * params.separationMaxAccel;
+
+        SteeringOutput cohesion, alignment;
+        if (cohesionCount > 0) {
+            Kinematic target; target.position = center / static_cast<float>(cohesionCount);
+            cohesion = arrive.calculateSteering(c, target);
+        }
+        if (alignmentCount > 0) {
+            Kinematic target; target.velocity = avgVelocity / static_cast<float>(alignmentCount);
+            alignment = velocityMatch.calculateSteering(c, target);
+        }
+
+        SteeringOutput out;
+        out.linear += separation * params.separationWeight;
+        out.linear += cohesion.linear * params.cohesionWeight;
+        out.linear += alignment.linear * params.alignmentWeight;
+        out.angular += cohesion.angular * params.cohesionWeight;
+        out.angular += alignment.angular * params.alignmentWeight;
+        mag = std::sqrt(out.linear.x*out.linear.x + out.linear.y*out.linear.y);
+        if (mag > params.maxAcceleration) out.linear = (out.linear / mag) * params.maxAcceleration;
+        if (std::abs(out.angular) > params.maxAngular) out.angular = (out.angular / std::abs(out.angular)) * params.maxAngular;
+        return out;
+    }
+};
+
+// ---------------- SoA flock ----------------
+// std::vector storage aligned for 256-bit loads
+template <class T, std::size_t Align = 32>
+struct AlignedAllocator {
+    using value_type = T;
+    AlignedAllocator() = default;
+    template <class U> AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+    template <class U> struct rebind { using other = AlignedAllocator<U, Align>; };
+    T *allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align))); }
+    void deallocate(T *p, std::size_t) { ::operator delete(p, std::align_val_t(Align)); }
+    template <class U> bool operator==(const AlignedAllocator<U, Align> &) const { return true; }
+    template <class U> bool operator!=(const AlignedAllocator<U, Align> &) const { return false; }
+};
+using AlignedFloats = std::vector<float, AlignedAllocator<float>>;
+
+// Boid state as parallel arrays, for flocks far larger than Case 4. Nothing
+// here touches SFML objects; rendering only reads x / y / orientation. Arrays
+// are padded with zeros to a multiple of 8 so the SIMD loops need no tail.
+class FlockSoA {
+    int count = 0;
+    static constexpr int LANES = 8;
+
+    void integrateScalar(int begin, int end, float dt) {
+        for (int i = begin; i < end; ++i) {
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+            vx[i] += ax[i] * dt;
+            vy[i] += ay[i] * dt;
+            float speed = std::sqrt(vx[i]*vx[i] + vy[i]*vy[i]);
+            if (speed > maxSpeed) { vx[i] = (vx[i] / speed) * maxSpeed; vy[i] = (vy[i] / speed) * maxSpeed; }
+            if (x[i] < 0.f) x[i] = WINDOW_WIDTH;
+            if (x[i] > WINDOW_WIDTH) x[i] = 0.f;
+            if (y[i] < 0.f) y[i] = WINDOW_HEIGHT;
+            if (y[i] > WINDOW_HEIGHT) y[i] = 0.f;
+        }
+    }
+public:
+    AlignedFloats x, y, vx, vy, orientation;
+    AlignedFloats ax, ay; // steering for the next integrate(), filled by the caller
+    AlignedFloats prevX, prevY, prevOrientation; // before the last integrate(), for drawing only
+    float maxSpeed = 200.f;
+
+    int size() const { return count; }
+
+    void clear() {
+        count = 0;
+        for (AlignedFloats *a : {&x, &y, &vx, &vy, &orientation, &ax, &ay, &prevX, &prevY, &prevOrientation}) a->clear();
+    }
+
+    void add(sf::Vector2f position, sf::Vector2f velocity) {
+        int padded = (count + 1 + LANES - 1) / LANES * LANES;
+        for (AlignedFloats *a : {&x, &y, &vx, &vy, &orientation, &ax, &ay, &prevX, &prevY, &prevOrientation}) a->resize(padded, 0.f);
+        x[count] = position.x; y[count] = position.y;
+        vx[count] = velocity.x; vy[count] = velocity.y;
+        orientation[count] = std::atan2(velocity.y, velocity.x);
+        prevX[count] = x[count]; prevY[count] = y[count]; prevOrientation[count] = orientation[count];
+        ++count;
+    }
+
+    // Same steps as Boid::update with a flocking behavior: move with the old
+    // velocity, apply steering, clamp speed, face the velocity, wrap at the edges.
+    // A range must start on a multiple of 8 so boids never share a SIMD block.
+    void integrate(float dt) { integrate(dt, 0, count); }
+    void integrate(float dt, int begin, int end) {
+        std::copy(x.begin() + begin, x.begin() + end, prevX.begin() + begin);
+        std::copy(y.begin() + begin, y.begin() + end, prevY.begin() + begin);
+        std::copy(orientation.begin() + begin, orientation.begin() + end, prevOrientation.begin() + begin);
+        int simdEnd = begin;
+        const int blockEnd = std::min((int)x.size(), (end + LANES - 1) / LANES * LANES); // padding is harmless
+#if defined(__AVX2__)
+        const __m256 vdt = _mm256_set1_ps(dt), vmax = _mm256_set1_ps(maxSpeed), zero = _mm256_setzero_ps();
+        const __m256 width = _mm256_set1_ps((float)WINDOW_WIDTH), height = _mm256_set1_ps((float)WINDOW_HEIGHT);
+        for (; simdEnd < blockEnd; simdEnd += 8) {
+            const int i = simdEnd;
+            __m256 px = _mm256_load_ps(&x[i]), py = _mm256_load_ps(&y[i]);
+            __m256 qx = _mm256_load_ps(&vx[i]), qy = _mm256_load_ps(&vy[i]);
+            px = _mm256_add_ps(px, _mm256_mul_ps(qx, vdt));
+            py = _mm256_add_ps(py, _mm256_mul_ps(qy, vdt));
+            qx = _mm256_add_ps(qx, _mm256_mul_ps(_mm256_load_ps(&ax[i]), vdt));
+            qy = _mm256_add_ps(qy, _mm256_mul_ps(_mm256_load_ps(&ay[i]), vdt));
+            // Lanes under the limit (including speed 0) keep their velocity, so the
+            // division result there is never used
+            __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(qx, qx), _mm256_mul_ps(qy, qy)));
+            __m256 over = _mm256_cmp_ps(speed, vmax, _CMP_GT_OQ);
+            qx = _mm256_blendv_ps(qx, _mm256_mul_ps(_mm256_div_ps(qx, speed), vmax), over);
+            qy = _mm256_blendv_ps(qy, _mm256_mul_ps(_mm256_div_ps(qy, speed), vmax), over);
+            px = _mm256_blendv_ps(px, width, _mm256_cmp_ps(px, zero, _CMP_LT_OQ));
+            px = _mm256_blendv_ps(px, zero, _mm256_cmp_ps(px, width, _CMP_GT_OQ));
+            py = _mm256_blendv_ps(py, height, _mm256_cmp_ps(py, zero, _CMP_LT_OQ));
+            py = _mm256_blendv_ps(py, zero, _mm256_cmp_ps(py, height, _CMP_GT_OQ));
+            _mm256_store_ps(&x[i], px); _mm256_store_ps(&y[i], py);
+            _mm256_store_ps(&vx[i], qx); _mm256_store_ps(&vy[i], qy);
+        }
+#elif defined(__SSE2__)
+        // No blendv before SSE4.1, so selects are and / andnot / or
+        auto select = [](__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+        const __m128 vdt = _mm_set1_ps(dt), vmax = _mm_set1_ps(maxSpeed), zero = _mm_setzero_ps();
+        const __m128 width = _mm_set1_ps((float)WINDOW_WIDTH), height = _mm_set1_ps((float)WINDOW_HEIGHT);
+        for (; simdEnd < blockEnd; simdEnd += 4) {
+            const int i = simdEnd;
+            __m128 px = _mm_load_ps(&x[i]), py = _mm_load_ps(&y[i]);
+            __m128 qx = _mm_load_ps(&vx[i]), qy = _mm_load_ps(&vy[i]);
+            px = _mm_add_ps(px, _mm_mul_ps(qx, vdt));
+            py = _mm_add_ps(py, _mm_mul_ps(qy, vdt));
+            qx = _mm_add_ps(qx, _mm_mul_ps(_mm_load_ps(&ax[i]), vdt));
+            qy = _mm_add_ps(qy, _mm_mul_ps(_mm_load_ps(&ay[i]), vdt));
+            __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)));
+            __m128 over = _mm_cmpgt_ps(speed, vmax);
+            qx = select(over, _mm_mul_ps(_mm_div_ps(qx, speed), vmax), qx);
+            qy = select(over, _mm_mul_ps(_mm_div_ps(qy, speed), vmax), qy);
+            px = select(_mm_cmplt_ps(px, zero), width, px);
+            px = select(_mm_cmpgt_ps(px, width), zero, px);
+            py = select(_mm_cmplt_ps(py, zero), height, py);
+            py = select(_mm_cmpgt_ps(py, height), zero, py);
+            _mm_store_ps(&x[i], px); _mm_store_ps(&y[i], py);
+            _mm_store_ps(&vx[i], qx); _mm_store_ps(&vy[i], qy);
+        }
+#endif
+        integrateScalar(simdEnd, end, dt);
+
+        // atan2 has no SIMD form, and only boids that are actually moving turn
+        for (int i = begin; i < end; ++i)
+            if (std::sqrt(vx[i]*vx[i] + vy[i]*vy[i]) > 0.01f) orientation[i] = std::atan2(vy[i], vx[i]);
+    }
+};
+
+// Steering of boid i from the current flock state, written to ax[i] / ay[i]
+void steerBoid(FlockSoA &flock, FlockingSteering &steering, const SpatialHashGrid &grid, int i) {
+    const float radius = steering.getParams().largestRadius();
+    Kinematic self;
+    self.position = {flock.x[i], flock.y[i]};
+    self.velocity = {flock.vx[i], flock.vy[i]};
+    SteeringOutput s = steering.steer(self, [&](auto &&visit) {
+        grid.forEachNear(self.position, radius, [&](int j) {
+            visit(sf::Vector2f(flock.x[j], flock.y[j]), sf::Vector2f(flock.vx[j], flock.vy[j]));
+        });
+    });
+    flock.ax[i] = s.linear.x;
+    flock.ay[i] = s.linear.y;
+}
+
+// Steering for every boid from the state at the start of the frame, then one
+// integrate() pass. Unlike Case 4 no boid sees a neighbour's updated position.
+void updateFlockSoA(FlockSoA &flock, FlockingSteering &steering, SpatialHashGrid &grid, float dt) {
+    grid.rebuild(flock.size(), [&](int i) { return sf::Vector2f(flock.x[i], flock.y[i]); });
+    for (int i = 0; i < flock.size(); ++i) steerBoid(flock, steering, grid, i);
+    flock.integrate(dt);
+}
+
+// Persistent helper threads for per-frame fork/join work; spawning threads every
+// frame would cost more than a 10k flock update. run() executes the job on every
+// helper and on the calling thread, and returns once all of them are done.
+class FlockWorkers {
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable wake, finished;
+    std::function<void()> job;
+    int generation = 0;
+    int busy = 0;
+    bool stopping = false;
+
+    void loop() {
+        int seen = 0;
+        while (true) {
+            std::function<void()> work;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                work = job;
+            }
+            work();
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--busy == 0) finished.notify_one();
+        }
+    }
+public:
+    explicit FlockWorkers(unsigned helpers) {
+        for (unsigned i = 0; i < helpers; ++i) threads.emplace_back(&FlockWorkers::loop, this);
+    }
+    ~FlockWorkers() {
+        { std::lock_guard<std::mutex> lock(mtx); stopping = true; }
+        wake.notify_all();
+        for (auto &t : threads) t.join();
+    }
+    unsigned size() const { return (unsigned)threads.size() + 1; }
+
+    void run(const std::function<void()> &fn) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            job = fn;
+            busy = (int)threads.size();
+            ++generation;
+        }
+        wake.notify_all();
+        fn();
+        std::unique_lock<std::mutex> lock(mtx);
+        finished.wait(lock, [&] { return busy == 0; });
+    }
+};
+
+// Parallel version of updateFlockSoA with identical results for any number of
+// threads. Positions / velocities are the front buffer and stay read-only while
+// ax / ay (the back buffer) are filled; threads claim whole grid cells from a
+// shared counter, so a thread that finishes early simply takes more cells and
+// neighbouring boids stay on the same core. Integration runs after the join, in
+// 8-aligned chunks claimed the same way.
+void updateFlockSoAParallel(FlockSoA &flock, FlockingSteering &steering, SpatialHashGrid &grid, float dt, FlockWorkers &workers) {
+    grid.rebuild(flock.size(), [&](int i) { return sf::Vector2f(flock.x[i], flock.y[i]); });
+
+    // steer() only reads the params and the stateless Arrive / VelocityMatching
+    std::atomic<int> nextCell{0};
+    workers.run([&] {
+        for (int c = nextCell++; c < grid.numCells(); c = nextCell++)
+            grid.forEachInCell(c, [&](int i) { steerBoid(flock, steering, grid, i); });
+    });
+
+    const int chunk = 1024;
+    std::atomic<int> nextChunk{0};
+    workers.run([&] {
+        for (int k = nextChunk++; k * chunk < flock.size(); k = nextChunk++)
+            flock.integrate(dt, k * chunk, std::min(flock.size(), (k + 1) * chunk));
+    });
+}
+
+// ---------------- texture cache / sprite batch ----------------
+// Each image is loaded from disk once and shared by every agent that uses it.
+// A flat square of fallbackColor stands in when the file is missing.
+const sf::Texture &sharedTexture(const std::string &file, unsigned fallbackSize, sf::Color fallbackColor) {
+    static std::map<std::string, std::unique_ptr<sf::Texture>> cache;
+    std::unique_ptr<sf::Texture> &slot = cache[file];
+    if (!slot) {
+        slot = std::make_unique<sf::Texture>();
+        if (!slot->loadFromFile(file)) {
+            sf::Image img({fallbackSize, fallbackSize}, sf::Color::Transparent);
+            for (unsigned y=0;y<fallbackSize;++y) for (unsigned x=0;x<fallbackSize;++x) img.setPixel({x,y}, fallbackColor);
+            (void)slot->loadFromImage(img);
+        }
+    }
+    return *slot;
+}
+
+// Collects centred, rotated, tinted copies of one texture into a triangle list
+// and draws them all with a single draw call. The vertex storage only grows, so
+// refilling it every frame does not allocate.
+class SpriteBatch {
+    const sf::Texture *texture;
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+    std::size_t used = 0;
+public:
+    explicit SpriteBatch(const sf::Texture &tex) : texture(&tex) {}
+
+    void clear() { used = 0; }
+
+    // Same placement as an sf::Sprite with its origin at the texture centre
+    void add(sf::Vector2f position, float orientation, float scale, sf::Color color) {
+        if (used + 6 > vertices.getVertexCount()) vertices.resize(std::max<std::size_t>(used + 6, vertices.getVertexCount() * 2));
+        sf::Vector2f size(texture->getSize());
+        float hx = size.x * 0.5f * scale, hy = size.y * 0.5f * scale;
+        float c = std::cos(orientation), s = std::sin(orientation);
+        auto corner = [&](float lx, float ly) { return position + sf::Vector2f(lx * c - ly * s, lx * s + ly * c); };
+        const sf::Vector2f pos[4] = { corner(-hx, -hy), corner(hx, -hy), corner(hx, hy), corner(-hx, hy) };
+        const sf::Vector2f uv[4] = { {0.f, 0.f}, {size.x, 0.f}, {size.x, size.y}, {0.f, size.y} };
+        for (int k : {0, 1, 2, 0, 2, 3}) {
+            sf::Vertex &v = vertices[used++];
+            v.position = pos[k];
+            v.texCoords = uv[k];
+            v.color = color;
+        }
+    }
+
+    void draw(sf::RenderTarget &target) const {
+        if (used > 0) target.draw(&vertices[0], used, sf::PrimitiveType::Triangles, sf::RenderStates(texture));
+    }
+};
+
 // ---------------- Character class (full) ----------------
 class Character {
     Kinematic kinematic;
+    Kinematic previous; // state before the last update, for interpolated drawing
     Breadcrumb breadcrumbs;
-    sf::Texture texture;
-    std::unique_ptr<sf::Sprite> sprite; // construct after texture
+    std::unique_ptr<sf::Sprite> sprite; // texture comes from sharedTexture()
     SteeringBehavior *currentBehavior;
     float maxSpeed;
     float maxRotation;
@@ -484,14 +1014,9 @@ public:
     {
         kinematic.position = start;
         kinematic.orientation = 0.f;
+        previous = kinematic;
 
-        // try load a real texture, otherwise build fallback
-        if (!texture.loadFromFile("boid.png")) {
-            sf::Image img({32u, 32u}, sf::Color::Transparent);
-            for (unsigned y=0;y<32;++y) for (unsigned x=0;x<32;++x) img.setPixel({x,y}, sf::Color(200,200,200));
-            (void)texture.loadFromImage(img);
-        }
-
+        const sf::Texture &texture = sharedTexture("boid.png", 32u, sf::Color(200,200,200));
         sprite = std::make_unique<sf::Sprite>(texture);
         sprite->setOrigin({ static_cast<float>(texture.getSize().x) / 2.f,
                             static_cast<float>(texture.getSize().y) / 2.f });
@@ -503,9 +1028,10 @@ public:
     Kinematic &getKinematic() { return kinematic; }
     void clearBreadcrumbs() { breadcrumbs.clear(); }
     void setMaxSpeed(float s) { maxSpeed = s; }
-    void setPosition(sf::Vector2f p) { kinematic.position = p; sprite->setPosition(p); }
+    void setPosition(sf::Vector2f p) { kinematic.position = p; previous = kinematic; }
 
     void update(float dt, const Kinematic &target) {
+        previous = kinematic;
         if (currentBehavior) {
             SteeringOutput s = currentBehavior->calculateSteering(kinematic, target);
             kinematic.position += kinematic.velocity * dt;
@@ -525,11 +1051,10 @@ public:
 
         kinematic.orientation = mapToRange(kinematic.orientation);
         breadcrumbs.update(kinematic.position);
-        sprite->setPosition(kinematic.position);
-        sprite->setRotation(sf::degrees(kinematic.orientation * 180.f / PI));
     }
 
     void updateWithBoundaryHandling(float dt, const Kinematic &target) {
+        previous = kinematic;
         if (currentBehavior) {
             SteeringOutput s = currentBehavior->calculateSteering(kinematic, target);
             kinematic.position += kinematic.velocity * dt;
@@ -555,11 +1080,13 @@ public:
 
         kinematic.orientation = mapToRange(kinematic.orientation);
         breadcrumbs.update(kinematic.position);
-        sprite->setPosition(kinematic.position);
-        sprite->setRotation(sf::degrees(kinematic.orientation * 180.f / PI));
     }
 
-    void draw(sf::RenderWindow &win) {
+    // alpha: 0 draws the state before the last update, 1 the current one
+    void draw(sf::RenderWindow &win, float alpha = 1.f) {
+        Kinematic pose = interpolate(previous, kinematic, alpha);
+        sprite->setPosition(pose.position);
+        sprite->setRotation(sf::degrees(pose.orientation * 180.f / PI));
         breadcrumbs.draw(win);
         win.draw(*sprite);
     }
@@ -569,32 +1096,25 @@ public:
 class Boid {
 public:
     Kinematic kinematic;
+    Kinematic previous; // for interpolated drawing
     Breadcrumb breadcrumbs;
-    sf::Texture texture;
-    std::unique_ptr<sf::Sprite> sprite;
-    BlendedSteering *flockingBehavior; // assigned externally
+    SteeringBehavior *flockingBehavior; // assigned externally
     float maxSpeed;
+    sf::Color color;
+
+    static const sf::Texture &texture() { return sharedTexture("boid-sm.png", 16u, sf::Color(180,180,180)); }
 
-    Boid(sf::Vector2f start, sf::Color color = sf::Color::Blue)
-        : breadcrumbs(20, 10, color), flockingBehavior(nullptr), maxSpeed(200.f)
+    Boid(sf::Vector2f start, sf::Color c = sf::Color::Blue)
+        : breadcrumbs(20, 10, c), flockingBehavior(nullptr), maxSpeed(200.f), color(c)
     {
         kinematic.position = start;
         kinematic.velocity = sf::Vector2f(randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f));
         kinematic.orientation = std::atan2(kinematic.velocity.y, kinematic.velocity.x);
-
-        if (!texture.loadFromFile("boid-sm.png")) {
-            sf::Image img({16u,16u}, sf::Color::Transparent);
-            for (unsigned y=0;y<16;++y) for (unsigned x=0;x<16;++x) img.setPixel({x,y}, sf::Color(180,180,180));
-            (void)texture.loadFromImage(img);
-        }
-
-        sprite = std::make_unique<sf::Sprite>(texture);
-        sprite->setOrigin({ static_cast<float>(texture.getSize().x)/2.f, static_cast<float>(texture.getSize().y)/2.f });
-        sprite->setScale({1.5f, 1.5f});
-        sprite->setColor(color);
+        previous = kinematic;
     }
 
     void update(float dt) {
+        previous = kinematic;
         if (flockingBehavior) {
             SteeringOutput s = flockingBehavior->calculateSteering(kinematic, kinematic);
             kinematic.position += kinematic.velocity * dt;
@@ -615,18 +1135,21 @@ public:
         if (kinematic.position.y > WINDOW_HEIGHT) kinematic.position.y = 0.f;
 
         breadcrumbs.update(kinematic.position);
-        sprite->setPosition(kinematic.position);
-        sprite->setRotation(sf::degrees(kinematic.orientation * 180.f / PI));
     }
 
-    void draw(sf::RenderWindow &win) {
-        breadcrumbs.draw(win);
-        win.draw(*sprite);
+    // Boids are drawn together: trails first, then one batch for all sprites
+    void drawTrail(sf::RenderWindow &win) { breadcrumbs.draw(win); }
+    void addTo(SpriteBatch &batch, float alpha = 1.f) const {
+        Kinematic pose = interpolate(previous, kinematic, alpha);
+        batch.add(pose.position, pose.orientation, 1.5f, color);
     }
 };
 
 // ---------------- main ----------------
-int main() {
+// Usage: steering [seed]
+int main(int argc, char **argv) {
+    if (argc > 1) threadRng().seed(std::strtoull(argv[1], nullptr, 10));
+
     sf::RenderWindow window(sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)),
                             "Steering Behaviors Demo (SFML 3.0.0)");
     window.setFramerateLimit(60);
@@ -683,6 +1206,22 @@ int main() {
     // Flocking
     std::vector<std::unique_ptr<Boid>> flock;
     std::vector<Kinematic*> flockKinematics;
+    SpatialHashGrid flockGrid; // indexes flockKinematics, rebuilt every frame
+    SpriteBatch flockBatch(Boid::texture());
+    FlockingParams flockParams;
+    flockGrid.setCellSize(flockParams.largestRadius());
+
+    // Every boid shares these, the behaviors keep no per-boid state
+    Separation flockSeparation(&flockKinematics, flockParams.separationRadius, flockParams.separationDecay, flockParams.separationMaxAccel, &flockGrid);
+    Cohesion flockCohesion(&flockKinematics, flockParams.cohesionRadius, flockParams.cohesionMaxAccel, &flockGrid);
+    Alignment flockAlignment(&flockKinematics, flockParams.alignmentRadius, flockParams.alignmentMaxAccel, &flockGrid);
+    BlendedSteering blendedFlocking(flockParams.maxAcceleration, flockParams.maxAngular);
+    blendedFlocking.addBehavior(&flockSeparation, flockParams.separationWeight);
+    blendedFlocking.addBehavior(&flockCohesion, flockParams.cohesionWeight);
+    blendedFlocking.addBehavior(&flockAlignment, flockParams.alignmentWeight);
+    FlockingSteering fusedFlocking(&flockKinematics, flockParams, &flockGrid);
+    bool useFusedFlocking = true; // F toggles, for comparing against the blended version
+
     auto initFlocking = [&]() {
         flock.clear(); flockKinematics.clear();
         int numBoids = 13;
@@ -692,20 +1231,32 @@ int main() {
             flock.push_back(std::make_unique<Boid>(p, color));
             flockKinematics.push_back(&flock.back()->kinematic);
         }
-        // give each boid a blended steering behavior
-        for (auto &b : flock) {
-            auto sep = new Separation(&flockKinematics, 40.f, 5000.f, 250.f);
-            auto coh = new Cohesion(&flockKinematics, 100.f, 80.f);
-            auto ali = new Alignment(&flockKinematics, 80.f, 100.f);
-            b->flockingBehavior = new BlendedSteering();
-            b->flockingBehavior->addBehavior(sep, 5.f);
-            b->flockingBehavior->addBehavior(coh, 0.7f);
-            b->flockingBehavior->addBehavior(ali, 0.7f);
-        }
+        for (auto &b : flock)
+            b->flockingBehavior = useFusedFlocking ? static_cast<SteeringBehavior*>(&fusedFlocking) : &blendedFlocking;
+    };
+
+    // Large flock (Case 5): same rules, radii scaled down so a 10k flock in one
+    // window still sees a few dozen neighbours each. Decay scales with dist^2.
+    FlockSoA largeFlock;
+    FlockingParams largeParams;
+    largeParams.separationRadius = 8.f;  largeParams.separationDecay = 200.f;
+    largeParams.cohesionRadius = 20.f;   largeParams.alignmentRadius = 16.f;
+    SpatialHashGrid largeGrid(largeParams.largestRadius());
+    FlockingSteering largeSteering(nullptr, largeParams);
+    SpriteBatch largeFlockBatch(Boid::texture());
+    unsigned cores = std::thread::hardware_concurrency();
+    FlockWorkers flockWorkers(cores > 1 ? cores - 1 : 0);
+    bool parallelFlock = true; // P toggles, results are the same either way
+    auto initLargeFlock = [&]() {
+        largeFlock.clear();
+        int numBoids = 10000;
+        for (int i=0;i<numBoids;++i)
+            largeFlock.add({randomFloat(0.f, WINDOW_WIDTH), randomFloat(0.f, WINDOW_HEIGHT)}, {randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f)});
     };
 
     initWander();
     initFlocking();
+    initLargeFlock();
 
     // Mouse target tracking
     Kinematic mouseTarget;
@@ -730,117 +1281,177 @@ int main() {
         if (mode == 2) { cyanAlignChar.setPosition({WINDOW_WIDTH/2.f, WINDOW_HEIGHT/2.f}); yellowArriveChar.setPosition({WINDOW_WIDTH/2.f, WINDOW_HEIGHT/2.f}); cyanAlignChar.clearBreadcrumbs(); yellowArriveChar.clearBreadcrumbs(); }
         if (mode == 3) initWander();
         if (mode == 4) initFlocking();
+        if (mode == 5) initLargeFlock();
     };
 
-    // main loop
-    while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
-        if (dt <= 0.f) dt = 0.016f;
-
-        // events (SFML 3)
-        while (true) {
-            std::optional<sf::Event> opt = window.pollEvent();
-            if (!opt) break;
-            const sf::Event &event = *opt;
-
-            if (event.is<sf::Event::Closed>()) {
-                window.close();
-            } else if (event.is<sf::Event::KeyPressed>()) {
-                const auto *kp = event.getIf<sf::Event::KeyPressed>();
-                if (kp) {
-                    if (kp->scancode == sf::Keyboard::Scancode::Escape) window.close();
-                    if (kp->scancode == sf::Keyboard::Scancode::Num1) resetCase(1);
-                    if (kp->scancode == sf::Keyboard::Scancode::Num2) resetCase(2);
-                    if (kp->scancode == sf::Keyboard::Scancode::Num3) resetCase(3);
-                    if (kp->scancode == sf::Keyboard::Scancode::Num4) resetCase(4);
-                }
-            } else if (event.is<sf::Event::MouseButtonPressed>()) {
-                const auto *mb = event.getIf<sf::Event::MouseButtonPressed>();
-                if (mb && currentMode == 2) {
-                    if (mb->button == sf::Mouse::Button::Left) {
-                        mouseTarget.position = sf::Vector2f(static_cast<float>(mb->position.x), static_cast<float>(mb->position.y));
-                        mouseTarget.orientation = randomFloat(-PI, PI);
-                    }
-                }
-            }
-        }
-
-        // update + render by mode
-        window.clear(sf::Color(30, 30, 40));
+    // main loop: simulation runs in fixed ticks, drawing interpolates between them
+    FixedTimestep tick(60.f, 5);
+    Arrive quickArrive(500.f, 500.f, 20.f, 150.f, 0.12f);
+    Arrive slowArrive(200.f, 200.f, 10.f, 150.f, 0.08f);
+    LookWhereYoureGoing lwg;
 
+    auto updateCase = [&](float dt) {
         switch (currentMode) {
-            case 1: {
-                modeText.setString("Case 1: Velocity Matching (Mouse)");
-                sf::Vector2i mouseInt = sf::Mouse::getPosition(window);
-                sf::Vector2f mousePos(static_cast<float>(mouseInt.x), static_cast<float>(mouseInt.y));
-                float elapsed = mouseClock.restart().asSeconds();
-                if (elapsed > 0.f) mouseTarget.velocity = (mousePos - lastMousePos) / elapsed;
-                mouseTarget.position = mousePos;
-                lastMousePos = mousePos;
-                mouseBreadcrumbs.update(mousePos);
+            case 1:
                 velMatchChar.setBehavior(&fastVelMatch);
                 velMatchChar.setMaxSpeed(250.f);
                 velMatchChar.update(dt, mouseTarget);
-                velMatchChar.draw(window);
-                mouseBreadcrumbs.draw(window);
-                sf::CircleShape targetShape(5.f);
-                targetShape.setFillColor(sf::Color::White);
-                targetShape.setOrigin({5.f, 5.f});
-                targetShape.setPosition(mousePos);
-                window.draw(targetShape);
                 break;
-            }
 
             case 2: {
-                modeText.setString("Case 2: Arrive + Align (Mouse)");
-                Arrive quickArrive(500.f, 500.f, 20.f, 150.f, 0.12f);
-                Arrive slowArrive(200.f, 200.f, 10.f, 150.f, 0.08f);
                 cyanAlignChar.setBehavior(&quickArrive);
                 yellowArriveChar.setBehavior(&slowArrive);
                 cyanAlignChar.update(dt, mouseTarget);
                 yellowArriveChar.update(dt, mouseTarget);
-                LookWhereYoureGoing lwg;
                 SteeringOutput s1 = lwg.calculateSteering(cyanAlignChar.getKinematic(), mouseTarget);
                 SteeringOutput s2 = lwg.calculateSteering(yellowArriveChar.getKinematic(), mouseTarget);
                 cyanAlignChar.getKinematic().rotation += s1.angular * dt;
                 cyanAlignChar.getKinematic().orientation += cyanAlignChar.getKinematic().rotation * dt;
                 yellowArriveChar.getKinematic().rotation += s2.angular * dt;
                 yellowArriveChar.getKinematic().orientation += yellowArriveChar.getKinematic().rotation * dt;
-                cyanAlignChar.draw(window);
-                yellowArriveChar.draw(window);
                 break;
             }
 
-            case 3: {
-                modeText.setString("Case 3: Wander (variants)");
+            case 3:
                 for (auto &c : wanderSet1) {
                     c->setBehavior(&wanderWithWalls1);
                     c->updateWithBoundaryHandling(dt, c->getKinematic());
-                    c->draw(window);
                 }
                 for (auto &c : wanderSet2) {
                     c->setBehavior(&wanderWithWalls2);
                     c->updateWithBoundaryHandling(dt, c->getKinematic());
-                    c->draw(window);
                 }
                 for (auto &c : wanderSet3) {
                     c->setBehavior(&wanderWithWalls3);
                     c->updateWithBoundaryHandling(dt, c->getKinematic());
-                    c->draw(window);
                 }
                 break;
+
+            case 4:
+                // Snapshot at tick start. Boids move a few pixels while the loop runs and
+                // distances are tested live, so at worst a neighbour that just crossed a
+                // cell edge is missed for one tick
+                flockGrid.rebuild(static_cast<int>(flockKinematics.size()), [&](int i) { return flockKinematics[i]->position; });
+                for (auto &b : flock) b->update(dt);
+                break;
+
+            case 5:
+                if (parallelFlock) updateFlockSoAParallel(largeFlock, largeSteering, largeGrid, dt, flockWorkers);
+                else updateFlockSoA(largeFlock, largeSteering, largeGrid, dt);
+                break;
+        }
+    };
+
+    auto drawCase = [&](float alpha) {
+        switch (currentMode) {
+            case 1: {
+                modeText.setString("Case 1: Velocity Matching (Mouse)");
+                velMatchChar.draw(window, alpha);
+                mouseBreadcrumbs.draw(window);
+                sf::CircleShape targetShape(5.f);
+                targetShape.setFillColor(sf::Color::White);
+                targetShape.setOrigin({5.f, 5.f});
+                targetShape.setPosition(mouseTarget.position);
+                window.draw(targetShape);
+                break;
             }
 
-            case 4: {
+            case 2:
+                modeText.setString("Case 2: Arrive + Align (Mouse)");
+                cyanAlignChar.draw(window, alpha);
+                yellowArriveChar.draw(window, alpha);
+                break;
+
+            case 3:
+                modeText.setString("Case 3: Wander (variants)");
+                for (auto *set : {&wanderSet1, &wanderSet2, &wanderSet3})
+                    for (auto &c : *set) c->draw(window, alpha);
+                break;
+
+            case 4:
                 modeText.setString("Case 4: Reynolds Boids");
+                flockBatch.clear();
                 for (auto &b : flock) {
-                    b->update(dt);
-                    b->draw(window);
+                    b->drawTrail(window);
+                    b->addTo(flockBatch, alpha);
                 }
+                flockBatch.draw(window);
                 break;
+
+            case 5:
+                modeText.setString("Case 5: Large Flock (" + std::to_string(largeFlock.size()) + " boids, " +
+                                   (parallelFlock ? std::to_string(flockWorkers.size()) + " threads)" : "serial)"));
+                largeFlockBatch.clear();
+                for (int i = 0; i < largeFlock.size(); ++i) {
+                    Kinematic from, to;
+                    from.position = {largeFlock.prevX[i], largeFlock.prevY[i]};
+                    from.orientation = largeFlock.prevOrientation[i];
+                    to.position = {largeFlock.x[i], largeFlock.y[i]};
+                    to.orientation = largeFlock.orientation[i];
+                    Kinematic pose = interpolate(from, to, alpha);
+                    sf::Color color = (i%3==0) ? sf::Color::Cyan : (i%3==1) ? sf::Color::Magenta : sf::Color::Yellow;
+                    largeFlockBatch.add(pose.position, pose.orientation, 0.5f, color);
+                }
+                largeFlockBatch.draw(window);
+                break;
+        }
+    };
+
+    while (window.isOpen()) {
+        float frameTime = clock.restart().asSeconds();
+
+        // events (SFML 3)
+        while (true) {
+            std::optional<sf::Event> opt = window.pollEvent();
+            if (!opt) break;
+            const sf::Event &event = *opt;
+
+            if (event.is<sf::Event::Closed>()) {
+                window.close();
+            } else if (event.is<sf::Event::KeyPressed>()) {
+                const auto *kp = event.getIf<sf::Event::KeyPressed>();
+                if (kp) {
+                    if (kp->scancode == sf::Keyboard::Scancode::Escape) window.close();
+                    if (kp->scancode == sf::Keyboard::Scancode::Num1) resetCase(1);
+                    if (kp->scancode == sf::Keyboard::Scancode::Num2) resetCase(2);
+                    if (kp->scancode == sf::Keyboard::Scancode::Num3) resetCase(3);
+                    if (kp->scancode == sf::Keyboard::Scancode::Num4) resetCase(4);
+                    if (kp->scancode == sf::Keyboard::Scancode::Num5) resetCase(5);
+                    if (kp->scancode == sf::Keyboard::Scancode::P) parallelFlock = !parallelFlock;
+                    if (kp->scancode == sf::Keyboard::Scancode::F) {
+                        useFusedFlocking = !useFusedFlocking;
+                        for (auto &b : flock)
+                            b->flockingBehavior = useFusedFlocking ? static_cast<SteeringBehavior*>(&fusedFlocking) : &blendedFlocking;
+                        std::cout << "Flocking: " << (useFusedFlocking ? "fused" : "blended") << std::endl;
+                    }
+                }
+            } else if (event.is<sf::Event::MouseButtonPressed>()) {
+                const auto *mb = event.getIf<sf::Event::MouseButtonPressed>();
+                if (mb && currentMode == 2) {
+                    if (mb->button == sf::Mouse::Button::Left) {
+                        mouseTarget.position = sf::Vector2f(static_cast<float>(mb->position.x), static_cast<float>(mb->position.y));
+                        mouseTarget.orientation = randomFloat(-PI, PI);
+                    }
+                }
             }
         }
 
+        // The mouse is sampled once per frame, ticks in between share the target
+        if (currentMode == 1) {
+            sf::Vector2i mouseInt = sf::Mouse::getPosition(window);
+            sf::Vector2f mousePos(static_cast<float>(mouseInt.x), static_cast<float>(mouseInt.y));
+            float elapsed = mouseClock.restart().asSeconds();
+            if (elapsed > 0.f) mouseTarget.velocity = (mousePos - lastMousePos) / elapsed;
+            mouseTarget.position = mousePos;
+            lastMousePos = mousePos;
+            mouseBreadcrumbs.update(mousePos);
+        }
+
+        for (int steps = tick.advance(frameTime); steps > 0; --steps) updateCase(tick.dt);
+
+        window.clear(sf::Color(30, 30, 40));
+        drawCase(tick.alpha());
+
         window.draw(modeText);
         window.display();
     }
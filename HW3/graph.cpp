@@ -1,30 +1,79 @@
 #include "graph.h"
-#include <random>
+#include "rng.h"
 #include <cmath>
 
 Graph::Graph(int n, bool spatial) : numVertices(n), adj(n) {
     if (spatial) positions.resize(n);
 }
 
+void CSRGraph::build(const std::vector<std::vector<std::pair<int, float>>>& adj) {
+    offsets.assign(adj.size() + 1, 0);
+    for (size_t u = 0; u < adj.size(); ++u) offsets[u + 1] = offsets[u] + (int)adj[u].size();
+
+    to.resize(offsets.back());
+    weight.resize(offsets.back());
+    for (size_t u = 0; u < adj.size(); ++u) {
+        int i = offsets[u];
+        for (const auto& [v, w] : adj[u]) {
+            to[i] = v;
+            weight[i] = w;
+            ++i;
+        }
+    }
+}
+
+void CSRGraph::buildReverse(const std::vector<std::vector<std::pair<int, float>>>& adj) {
+    offsets.assign(adj.size() + 1, 0);
+    for (const auto& edges : adj)
+        for (const auto& e : edges) offsets[e.first + 1]++;
+    for (size_t v = 0; v < adj.size(); ++v) offsets[v + 1] += offsets[v];
+
+    to.resize(offsets.back());
+    weight.resize(offsets.back());
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t u = 0; u < adj.size(); ++u) {
+        for (const auto& [v, w] : adj[u]) {
+            to[fill[v]] = (int)u;
+            weight[fill[v]] = w;
+            ++fill[v];
+        }
+    }
+}
+
+void CSRGraph::clear() {
+    offsets.clear();
+    to.clear();
+    weight.clear();
+}
+
 void Graph::addEdge(int u, int v, float w) {
     adj[u].emplace_back(v, w);
+    if (isFinalized()) {
+        csr.clear();
+        rcsr.clear();
+    }
+}
+
+void Graph::finalize() {
+    csr.build(adj);
+    rcsr.buildReverse(adj);
 }
 
 void Graph::generateRandomLarge(int n, int avgDegree) {
     numVertices = n;
     adj.resize(n);
-    std::mt19937 gen(std::random_device{}());
-    std::uniform_real_distribution<float> dis(0.f, 1.f);
+    Rng& rng = threadRng();
     float p = static_cast<float>(avgDegree) / (n - 1); // Erdos-Renyi for avg degree
     for (int u = 0; u < n; ++u) {
         for (int v = 0; v < n; ++v) {
-            if (u != v && dis(gen) < p) {
-                float w = dis(gen) * 100.f + 1.f; // positive >0
+            if (u != v && rng.uniform() < p) {
+                float w = rng.uniform() * 100.f + 1.f; // positive >0
                 addEdge(u, v, w);
                 addEdge(v, u, w); // undirected for simplicity
             }
         }
     }
+    finalize();
 }
 
 Graph createSmallCampusGraph() {
@@ -70,5 +119,6 @@ Graph createSmallCampusGraph() {
         }
     }
 
+    g.finalize();
     return g;
 }
\ No newline at end of file
@@ -5,14 +5,41 @@
 #include <utility> // pair
 #include <SFML/Graphics.hpp> // for positions
 
+// Frozen CSR adjacency: edges of u are [offsets[u], offsets[u+1]) in to/weight
+struct CSRGraph {
+    std::vector<int> offsets;
+    std::vector<int> to;
+    std::vector<float> weight;
+
+    void build(const std::vector<std::vector<std::pair<int, float>>>& adj);
+    void buildReverse(const std::vector<std::vector<std::pair<int, float>>>& adj); // edges v->u for every u->v
+    void clear();
+    bool empty() const { return offsets.empty(); }
+};
+
+// Calls fn(v, weight) for every out-edge of u, for either adjacency layout
+template <class Fn>
+inline void forEachEdge(const std::vector<std::vector<std::pair<int, float>>>& adj, int u, Fn&& fn) {
+    for (const auto& [v, w] : adj[u]) fn(v, w);
+}
+
+template <class Fn>
+inline void forEachEdge(const CSRGraph& csr, int u, Fn&& fn) {
+    for (int i = csr.offsets[u], end = csr.offsets[u + 1]; i < end; ++i) fn(csr.to[i], csr.weight[i]);
+}
+
 class Graph {
 public:
     int numVertices;
     std::vector<std::vector<std::pair<int, float>>> adj; // adj[u] = {v, weight}
+    CSRGraph csr; // built by finalize(), preferred by the searches
+    CSRGraph rcsr; // reverse edges, built by finalize() for backward searches
     std::vector<sf::Vector2f> positions; // optional for spatial
 
     Graph(int n, bool spatial = false);
-    void addEdge(int u, int v, float w);
+    void addEdge(int u, int v, float w); // drops csr if already finalized
+    void finalize(); // freeze adj into csr once construction is done
+    bool isFinalized() const { return !csr.empty(); }
     void generateRandomLarge(int n, int avgDegree); // for large
 };
 
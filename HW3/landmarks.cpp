@@ -0,0 +1,166 @@
+#include "landmarks.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <thread>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const float INF = std::numeric_limits<float>::infinity();
+const std::uint16_t UNREACHABLE = 0xFFFF;
+
+struct LandmarkTables {
+    int stride = 0;  // landmarks per row, padded to a multiple of 8 (padding rows are 0)
+    float scale = 0; // distance of one quantization step
+    std::vector<int> nodes;
+    std::vector<std::uint16_t> from; // from[v * stride + k] ~ d(L_k, v)
+    std::vector<std::uint16_t> to;   // to[v * stride + k]   ~ d(v, L_k)
+};
+LandmarkTables tables; // global for simplicity
+
+// Full single-source Dijkstra over a CSR adjacency
+void shortestFrom(const CSRGraph& csr, int source, std::vector<float>& dist) {
+    using pii = std::pair<float, int>;
+    dist.assign(csr.offsets.size() - 1, INF);
+    dist[source] = 0.f;
+    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq;
+    pq.push({0.f, source});
+    while (!pq.empty()) {
+        float d = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
+        if (d > dist[u]) continue; // stale entry
+        forEachEdge(csr, u, [&](int v, float w) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
+                pq.push({dist[v], v});
+            }
+        });
+    }
+}
+
+} // namespace
+
+void initLandmarks(const Graph& g, int numLandmarks) {
+    tables = LandmarkTables{};
+    const int n = g.numVertices;
+    const int K = std::min(numLandmarks, n);
+    if (K <= 0) return;
+
+    CSRGraph forward, backward;
+    if (!g.isFinalized()) {
+        forward.build(g.adj);
+        backward.buildReverse(g.adj);
+    }
+    const CSRGraph& fwd = g.isFinalized() ? g.csr : forward;
+    const CSRGraph& rev = g.isFinalized() ? g.rcsr : backward;
+
+    // Farthest-point selection: each new landmark is the reachable vertex whose
+    // distance to the closest landmark so far is largest. The Dijkstra run for
+    // each pick doubles as that landmark's forward table.
+    std::vector<std::vector<float>> fromDist(K), toDist(K);
+    std::vector<float> nearest(n, INF);
+    std::vector<float> probe;
+    shortestFrom(fwd, 0, probe);
+    int next = 0;
+    for (int v = 0; v < n; ++v)
+        if (probe[v] < INF && probe[v] > probe[next]) next = v;
+
+    for (int k = 0; k < K; ++k) {
+        tables.nodes.push_back(next);
+        shortestFrom(fwd, next, fromDist[k]);
+        for (int v = 0; v < n; ++v) nearest[v] = std::min(nearest[v], fromDist[k][v]);
+
+        // Vertices nobody reaches are skipped, they would only cover themselves
+        next = -1;
+        for (int v = 0; v < n; ++v)
+            if (nearest[v] < INF && (next == -1 || nearest[v] > nearest[next])) next = v;
+        if (next == -1 || nearest[next] == 0.f) { // fewer useful landmarks than asked for
+            fromDist.resize(k + 1);
+            toDist.resize(k + 1);
+            break;
+        }
+    }
+    const int count = (int)fromDist.size();
+
+    // Reverse tables are independent of each other, so fan them out
+    std::atomic<int> claim{0};
+    auto worker = [&]() {
+        for (int k = claim++; k < count; k = claim++) shortestFrom(rev, tables.nodes[k], toDist[k]);
+    };
+    unsigned threads = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned)count));
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    // Quantize with floor so the true distance lies in [q, q + 1) steps
+    float maxDist = 0.f;
+    for (int k = 0; k < count; ++k) {
+        for (int v = 0; v < n; ++v) {
+            if (fromDist[k][v] < INF) maxDist = std::max(maxDist, fromDist[k][v]);
+            if (toDist[k][v] < INF) maxDist = std::max(maxDist, toDist[k][v]);
+        }
+    }
+    tables.scale = maxDist > 0.f ? maxDist / (UNREACHABLE - 1) : 1.f;
+    tables.stride = (count + 7) / 8 * 8;
+    tables.from.assign((size_t)n * tables.stride, 0);
+    tables.to.assign((size_t)n * tables.stride, 0);
+
+    auto quantize = [](float d) {
+        if (d == INF) return UNREACHABLE;
+        return (std::uint16_t)std::min<float>(UNREACHABLE - 1, d / tables.scale);
+    };
+    for (int v = 0; v < n; ++v) {
+        for (int k = 0; k < count; ++k) {
+            tables.from[(size_t)v * tables.stride + k] = quantize(fromDist[k][v]);
+            tables.to[(size_t)v * tables.stride + k] = quantize(toDist[k][v]);
+        }
+    }
+
+    std::cout << "ALT: " << count << " landmarks, step " << tables.scale << ", "
+              << (tables.from.size() + tables.to.size()) * sizeof(std::uint16_t) / 1024 << " KB" << std::endl;
+}
+
+// Quantized values only bound each distance to within one step, so every
+// difference is lowered by one step before scaling. UNREACHABLE behaves like
+// a huge distance: d(L,t) = inf with d(L,u) finite means u cannot reach t at
+// all, so the large estimate is still a valid lower bound.
+float landmarkHeur(int u, int v, const Graph& g) {
+    (void)g;
+    if (tables.stride == 0 || u == v) return 0.f;
+    const std::uint16_t* fu = &tables.from[(size_t)u * tables.stride];
+    const std::uint16_t* fv = &tables.from[(size_t)v * tables.stride];
+    const std::uint16_t* tu = &tables.to[(size_t)u * tables.stride];
+    const std::uint16_t* tv = &tables.to[(size_t)v * tables.stride];
+
+    int best = 0;
+#if defined(__SSE2__)
+    // Saturating subtract gives max(a - b, 0) per lane; SSE2 only has a signed
+    // 16-bit max, so flip the sign bit to compare unsigned values with it.
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    __m128i acc = bias; // biased 0
+    for (int k = 0; k < tables.stride; k += 8) {
+        __m128i a = _mm_subs_epu16(_mm_loadu_si128((const __m128i*)(fv + k)), _mm_loadu_si128((const __m128i*)(fu + k)));
+        __m128i b = _mm_subs_epu16(_mm_loadu_si128((const __m128i*)(tu + k)), _mm_loadu_si128((const __m128i*)(tv + k)));
+        acc = _mm_max_epi16(acc, _mm_xor_si128(a, bias));
+        acc = _mm_max_epi16(acc, _mm_xor_si128(b, bias));
+    }
+    acc = _mm_max_epi16(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_max_epi16(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_max_epi16(acc, _mm_srli_si128(acc, 2));
+    best = (_mm_cvtsi128_si32(acc) ^ 0x8000) & 0xFFFF;
+#else
+    for (int k = 0; k < tables.stride; ++k) {
+        best = std::max(best, (int)fv[k] - (int)fu[k]);
+        best = std::max(best, (int)tu[k] - (int)tv[k]);
+    }
+#endif
+    return best > 1 ? (float)(best - 1) * tables.scale : 0.f;
+}
@@ -0,0 +1,18 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "graph.h"
+
+// ALT heuristic (A*, Landmarks, Triangle inequality) for graphs without
+// meaningful positions. For every landmark L we keep d(L,v) and d(v,L), and
+//   h(u,t) = max over L of max(d(L,t) - d(L,u), d(u,L) - d(t,L))
+// which is a lower bound on d(u,t) for directed graphs too.
+
+// Picks numLandmarks landmarks by farthest-point selection and precomputes the
+// distance tables (reverse Dijkstras run in parallel). Tables are stored as
+// uint16 steps of a common scale, rounded so the bound stays admissible.
+void initLandmarks(const Graph& g, int numLandmarks);
+
+float landmarkHeur(int u, int v, const Graph& g);
+
+#endif
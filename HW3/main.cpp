@@ -1,12 +1,18 @@
 #include "graph.h"
 #include "pathfinding.h"
+#include "landmarks.h"
 #include "steering.h"
+#include "rng.h"
 #include <iostream>
+#include <cstdlib>
 #include <SFML/Graphics.hpp>
 #include <optional>
 #include <cmath>
 
-int main() {
+// Usage: hw3 [seed] -- a seed makes the random graph and test pairs repeatable
+int main(int argc, char** argv) {
+    if (argc > 1) seedThreadRng(std::strtoull(argv[1], nullptr, 10));
+
     // Part 1: Graphs
     Graph small = createSmallCampusGraph();
     std::cout << "Small graph: UKy Campus, 40 verts" << std::endl;
@@ -14,12 +20,12 @@ int main() {
     large.generateRandomLarge(50000, 4); // avg degree 4, ~200k edges
     std::cout << "Large graph: Random, 50k verts" << std::endl;
 
-    // Init clusters for large
-    initClusters(large, 100);
+    // Landmark tables for the large graph's heuristic
+    initLandmarks(large, 16);
 
     // Part 2: Dijkstra/A* compare on small
     for (int test = 0; test < 5; ++test) {
-        int s = rand() % small.numVertices, g = rand() % small.numVertices;
+        int s = threadRng().below(small.numVertices), g = threadRng().below(small.numVertices);
         Metrics md, ma;
         dijkstra(small, s, g, md);
         aStar(small, s, g, euclideanHeur, ma);
@@ -29,17 +35,22 @@ int main() {
 
     // On large
     for (int test = 0; test < 5; ++test) {
-        int s = rand() % large.numVertices, g = rand() % large.numVertices;
-        Metrics md, ma;
+        int s = threadRng().below(large.numVertices), g = threadRng().below(large.numVertices);
+        Metrics md, ma, mbd, mba;
         dijkstra(large, s, g, md);
-        aStar(large, s, g, clusterHeur, ma);
+        aStar(large, s, g, landmarkHeur, ma);
+        bidirectionalDijkstra(large, s, g, mbd);
+        bidirectionalAStar(large, s, g, landmarkHeur, mba);
         std::cout << "Large Test " << test << ": Dijk rt=" << md.runtime_ms << " fringe=" << md.max_fringe << " fill=" << md.fill << std::endl;
         std::cout << "A* rt=" << ma.runtime_ms << " fringe=" << ma.max_fringe << " fill=" << ma.fill << std::endl;
+        std::cout << "Bidir Dijk rt=" << mbd.runtime_ms << " fringe=" << mbd.max_fringe << " fill=" << mbd.fill << std::endl;
+        std::cout << "Bidir A* rt=" << mba.runtime_ms << " fringe=" << mba.max_fringe << " fill=" << mba.fill << std::endl;
     }
 
     // Part 3: Heuristics on small
     analyzeHeur(small, euclideanHeur, true);
     analyzeHeur(small, overEstHeur, false);
+    analyzeHeur(large, landmarkHeur, true);
 
     // Part 4: Integration SFML
     sf::RenderWindow window(sf::VideoMode({static_cast<unsigned>(WINDOW_WIDTH), static_cast<unsigned>(WINDOW_HEIGHT)}), "HW3 Integration");
@@ -134,6 +145,8 @@ int main() {
         }
     }
 
+    indoor.finalize();
+
     // Prepare wall shapes for drawing
     std::vector<sf::RectangleShape> wallShapes;
     for (int obs : obstacles) {
@@ -151,9 +164,9 @@ int main() {
     chara.getKinematic().velocity = {0.f, 0.f}; // Start stationary
 
     sf::Clock clock;
+    FixedTimestep tick(60.f, 5); // path following runs at 60 Hz whatever the frame rate
     while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
-        if (dt <= 0.f) dt = 0.016f;
+        float frameTime = clock.restart().asSeconds();
 
         // Event loop
         while (true) {
@@ -191,14 +204,14 @@ int main() {
 
         // Update character (passes dummy, but handles path inside)
         Kinematic dummy;
-        chara.update(dt, dummy);
+        for (int steps = tick.advance(frameTime); steps > 0; --steps) chara.update(tick.dt, dummy);
 
         window.clear(sf::Color(30, 30, 40));
         // Draw walls
         for (auto& rect : wallShapes) {
             window.draw(rect);
         }
-        chara.draw(window);
+        chara.draw(window, tick.alpha());
         window.display();
     }
 
@@ -1,14 +1,17 @@
 #include "pathfinding.h"
+#include "rng.h"
 #include <queue>
 #include <set>
+#include <algorithm>
 #include <limits>
 #include <iostream>
-#include <random> // Added
 #include <cmath> // Added for std::sqrt, std::abs
 
 using pii = std::pair<float, int>; // dist, node
 
-std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m) {
+// Search bodies are templated over the adjacency layout (adj lists or CSR)
+template <class Adjacency>
+static std::vector<int> dijkstraImpl(const Graph& g, const Adjacency& adj, int start, int goal, Metrics& m) {
     auto t0 = std::chrono::high_resolution_clock::now();
     std::vector<float> dist(g.numVertices, std::numeric_limits<float>::infinity());
     std::vector<int> prev(g.numVertices, -1);
@@ -20,19 +23,21 @@ std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m) {
     m.fill = 0;
 
     while (!pq.empty()) {
-        auto [d, u] = pq.top(); pq.pop();
+        float d = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
         if (visited.count(u)) continue;
         visited.insert(u);
         m.fill++;
         if (u == goal) break;
 
-        for (auto [v, w] : g.adj[u]) {
+        forEachEdge(adj, u, [&](int v, float w) {
             if (d + w < dist[v]) {
                 dist[v] = d + w;
                 prev[v] = u;
                 pq.push({dist[v], v});
             }
-        }
+        });
         m.max_fringe = std::max(m.max_fringe, (int)pq.size());
     }
 
@@ -46,7 +51,8 @@ std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m) {
     return (path.front() == start) ? path : std::vector<int>{};
 }
 
-std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m) {
+template <class Adjacency>
+static std::vector<int> aStarImpl(const Graph& g, const Adjacency& adj, int start, int goal, const Heuristic& h, Metrics& m) {
     auto t0 = std::chrono::high_resolution_clock::now();
     std::vector<float> gscore(g.numVertices, std::numeric_limits<float>::infinity());
     std::vector<float> fscore(g.numVertices, std::numeric_limits<float>::infinity());
@@ -60,13 +66,14 @@ std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics
     m.fill = 0;
 
     while (!pq.empty()) {
-        auto [f, u] = pq.top(); pq.pop();
+        int u = pq.top().second; // f only orders the queue
+        pq.pop();
         if (visited.count(u)) continue;
         visited.insert(u);
         m.fill++;
         if (u == goal) break;
 
-        for (auto [v, w] : g.adj[u]) {
+        forEachEdge(adj, u, [&](int v, float w) {
             float tent_g = gscore[u] + w;
             if (tent_g < gscore[v]) {
                 prev[v] = u;
@@ -74,7 +81,7 @@ std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics
                 fscore[v] = tent_g + h(v, goal, g);
                 pq.push({fscore[v], v});
             }
-        }
+        });
         m.max_fringe = std::max(m.max_fringe, (int)pq.size());
     }
 
@@ -87,6 +94,97 @@ std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics
     return (path.front() == start) ? path : std::vector<int>{};
 }
 
+// Bidirectional body. pf is the forward potential and the backward side uses
+// -pf, so keys are gF + pf and gR - pf. Every meeting edge u->v found while
+// relaxing updates mu = gF(u) + w + gR(v); once the two queue tops sum to mu
+// or more no better meeting is left (pf = 0 gives bidirectional Dijkstra).
+template <class Adjacency, class Potential>
+static std::vector<int> bidirectionalImpl(const Graph& g, const Adjacency& fwd, const Adjacency& rev,
+                                          int start, int goal, Potential pf, Metrics& m) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const float INF = std::numeric_limits<float>::infinity();
+    std::vector<float> dist[2] = {std::vector<float>(g.numVertices, INF), std::vector<float>(g.numVertices, INF)};
+    std::vector<int> prev[2] = {std::vector<int>(g.numVertices, -1), std::vector<int>(g.numVertices, -1)};
+    std::vector<char> done[2] = {std::vector<char>(g.numVertices, 0), std::vector<char>(g.numVertices, 0)};
+    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq[2]; // key, node
+    dist[0][start] = 0;
+    dist[1][goal] = 0;
+    pq[0].push({pf(start), start});
+    pq[1].push({-pf(goal), goal});
+    float mu = (start == goal) ? 0.f : INF;
+    int meetF = start, meetR = goal;
+    m.max_fringe = 2;
+    m.fill = 0;
+
+    while (!pq[0].empty() && !pq[1].empty()) {
+        if (pq[0].top().first + pq[1].top().first >= mu) break;
+        int side = pq[0].size() <= pq[1].size() ? 0 : 1; // grow the smaller frontier
+        int u = pq[side].top().second;
+        pq[side].pop();
+        if (done[side][u]) continue;
+        done[side][u] = 1;
+        m.fill++;
+
+        const float du = dist[side][u];
+        const float sign = side == 0 ? 1.f : -1.f;
+        auto relax = [&](int v, float w) {
+            if (du + w < dist[side][v]) {
+                dist[side][v] = du + w;
+                prev[side][v] = u;
+                pq[side].push({du + w + sign * pf(v), v});
+            }
+            if (du + w + dist[1 - side][v] < mu) {
+                mu = du + w + dist[1 - side][v];
+                meetF = side == 0 ? u : v;
+                meetR = side == 0 ? v : u;
+            }
+        };
+        if (side == 0) forEachEdge(fwd, u, relax);
+        else forEachEdge(rev, u, relax);
+        m.max_fringe = std::max(m.max_fringe, (int)(pq[0].size() + pq[1].size()));
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    m.runtime_ms = std::chrono::duration<float, std::milli>(t1 - t0).count();
+
+    std::vector<int> path;
+    if (mu == INF) return path;
+    for (int at = meetF; at != -1; at = prev[0][at]) path.push_back(at);
+    std::reverse(path.begin(), path.end());
+    if (meetR != meetF) {
+        for (int at = meetR; at != -1; at = prev[1][at]) path.push_back(at);
+    }
+    return path;
+}
+
+std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m) {
+    if (g.isFinalized()) return dijkstraImpl(g, g.csr, start, goal, m);
+    return dijkstraImpl(g, g.adj, start, goal, m);
+}
+
+std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m) {
+    if (g.isFinalized()) return aStarImpl(g, g.csr, start, goal, h, m);
+    return aStarImpl(g, g.adj, start, goal, h, m);
+}
+
+template <class Potential>
+static std::vector<int> bidirectional(const Graph& g, int start, int goal, Potential pf, Metrics& m) {
+    if (g.isFinalized()) return bidirectionalImpl(g, g.csr, g.rcsr, start, goal, pf, m);
+    CSRGraph fwd, rev; // not frozen yet: build both directions for this query
+    fwd.build(g.adj);
+    rev.buildReverse(g.adj);
+    return bidirectionalImpl(g, fwd, rev, start, goal, pf, m);
+}
+
+std::vector<int> bidirectionalDijkstra(const Graph& g, int start, int goal, Metrics& m) {
+    return bidirectional(g, start, goal, [](int) { return 0.f; }, m);
+}
+
+std::vector<int> bidirectionalAStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m) {
+    auto pf = [&](int v) { return 0.5f * (h(v, goal, g) - h(start, v, g)); };
+    return bidirectional(g, start, goal, pf, m);
+}
+
 float euclideanHeur(int u, int v, const Graph& g) {
     auto d = g.positions[u] - g.positions[v];
     return std::sqrt(d.x * d.x + d.y * d.y);
@@ -96,32 +194,13 @@ float overEstHeur(int u, int v, const Graph& g) {
     return 2.f * euclideanHeur(u, v, g); // inadmissible
 }
 
-// Clusters for large (simple: ID / (n/clusters))
-std::vector<int> cluster; // global for simplicity
-std::vector<float> clusterCenter; // avg ID or something
-void initClusters(const Graph& g, int numClusters) {
-    cluster.resize(g.numVertices);
-    for (int i = 0; i < g.numVertices; ++i) cluster[i] = i % numClusters;
-    clusterCenter.resize(numClusters, 0.f);
-    // Fake centers: cluster ID * (g.numVertices / numClusters)
-    for (int c = 0; c < numClusters; ++c) clusterCenter[c] = c * 10.f; // arbitrary
-}
-
-float clusterHeur(int u, int v, const Graph& g) {
-    (void)g; // Suppress unused warning
-    int cu = cluster[u], cv = cluster[v];
-    if (cu == cv) return 0.f;
-    return std::abs(clusterCenter[cu] - clusterCenter[cv]); // reasonable dist
-}
-
 void analyzeHeur(const Graph& g, Heuristic h, bool admissible) {
     int overCount = 0;
     float totalOver = 0.f;
     int samples = 100;
-    std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<int> dis(0, g.numVertices - 1);
+    Rng& rng = threadRng();
     for (int i = 0; i < samples; ++i) {
-        int s = dis(gen), goal = dis(gen);
+        int s = rng.below(g.numVertices), goal = rng.below(g.numVertices);
         Metrics m;
         auto path = dijkstra(g, s, goal, m); // true dist
         if (path.empty()) continue;
@@ -22,13 +22,18 @@ using Heuristic = std::function<float(int, int, const Graph&)>;
 // A* with heuristic
 std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m);
 
+// Bidirectional variants: a backward search over g.rcsr meets the forward one,
+// stopping once no shorter meeting path can exist. fill counts both sides.
+// The A* version uses average potentials, so h must be consistent both ways
+// (h(s,v) is used as a lower bound on d(s,v)).
+std::vector<int> bidirectionalDijkstra(const Graph& g, int start, int goal, Metrics& m);
+std::vector<int> bidirectionalAStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m);
+
 // Heuristics for small (spatial)
 float euclideanHeur(int u, int v, const Graph& g); // admissible
 float overEstHeur(int u, int v, const Graph& g); // inadmissible 2x eucl
 
-// For large (cluster)
-void initClusters(const Graph& g, int numClusters); // global or something
-float clusterHeur(int u, int v, const Graph& g);
+// For large (non-spatial): ALT landmarks, see landmarks.h
 
 // Analysis funcs
 void analyzeHeur(const Graph& g, Heuristic h, bool admissible); // prints freq overest etc
@@ -0,0 +1,63 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <random>
+
+// PCG32 (O'Neill): 8 bytes of state plus a stream id, a multiply and a
+// rotate per number. Also a standard
+// UniformRandomBitGenerator, so it works with std::shuffle and the
+// <random> distributions.
+class Rng {
+public:
+    using result_type = std::uint32_t;
+
+    explicit Rng(std::uint64_t seedValue = 0x853c49e6748fea9bULL, std::uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        seed(seedValue, stream);
+    }
+
+    // Different streams give unrelated sequences for the same seed
+    void seed(std::uint64_t seedValue, std::uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        state = 0;
+        inc = (stream << 1) | 1u;
+        next();
+        state += seedValue;
+        next();
+    }
+
+    std::uint32_t next() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        std::uint32_t xorshifted = (std::uint32_t)(((old >> 18) ^ old) >> 27);
+        std::uint32_t rot = (std::uint32_t)(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    // [0, 1) with 24 bits, every value exactly representable as a float
+    float uniform() { return (next() >> 8) * (1.f / 16777216.f); }
+    float range(float a, float b) { return a + (b - a) * uniform(); }
+    // In (-1, 1), more likely near 0 (wander jitter)
+    float binomial() { return uniform() - uniform(); }
+    // [0, n), n > 0; multiply-shift instead of %, the bias is below 2^-32 * n
+    int below(int n) { return (int)(((std::uint64_t)next() * (std::uint32_t)n) >> 32); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xffffffffu; }
+    result_type operator()() { return next(); }
+
+private:
+    std::uint64_t state;
+    std::uint64_t inc;
+};
+
+// Per-thread generator behind randomFloat() / randomBinomial(), the random
+// graph and the benchmark queries; seeded from std::random_device unless seedThreadRng() is
+// called on that thread first.
+inline Rng& threadRng() {
+    thread_local Rng rng(((std::uint64_t)std::random_device{}() << 32) | std::random_device{}());
+    return rng;
+}
+
+inline void seedThreadRng(std::uint64_t seed) { threadRng().seed(seed); }
+
+#endif
@@ -7,48 +7,52 @@ float mapToRange(float rotation) {
     return rotation;
 }
 
-float randomBinomial() {
-    static std::mt19937 gen(std::random_device{}());
-    static std::uniform_real_distribution<float> dis(0.f, 1.f);
-    return dis(gen) - dis(gen);
-}
+float randomBinomial() { return threadRng().binomial(); }
 
-float randomFloat(float a, float b) {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_real_distribution<float> dis(a, b);
-    return dis(gen);
-}
+float randomFloat(float a, float b) { return threadRng().range(a, b); }
 
 // Breadcrumb
+// Appends a filled octagon (8 triangles) around center to a Triangles array
+static void appendDot(sf::VertexArray &mesh, std::size_t &v, sf::Vector2f center, float radius, sf::Color col) {
+    static const sf::Vector2f octagon[8] = {{1.f, 0.f}, {0.7071068f, 0.7071068f}, {0.f, 1.f}, {-0.7071068f, 0.7071068f},
+                                            {-1.f, 0.f}, {-0.7071068f, -0.7071068f}, {0.f, -1.f}, {0.7071068f, -0.7071068f}};
+    for (int k = 0; k < 8; ++k) {
+        mesh[v++] = sf::Vertex{center, col};
+        mesh[v++] = sf::Vertex{center + octagon[k] * radius, col};
+        mesh[v++] = sf::Vertex{center + octagon[(k + 1) % 8] * radius, col};
+    }
+}
+
 Breadcrumb::Breadcrumb(int maxCrumbs_, int dropInterval_, sf::Color c)
-    : maxCrumbs(maxCrumbs_), dropInterval(dropInterval_), counter(0), color(c) {}
+    : ring(std::max(0, maxCrumbs_)), head(0), count(0), maxCrumbs(maxCrumbs_), dropInterval(dropInterval_),
+      counter(0), color(c), mesh(sf::PrimitiveType::Triangles) {}
 
 void Breadcrumb::update(const sf::Vector2f &pos) {
     if (++counter >= dropInterval) {
         counter = 0;
-        q.push(pos);
-        if ((int)q.size() > maxCrumbs) q.pop();
+        if (maxCrumbs <= 0) return;
+        if (count < maxCrumbs) ring[(head + count++) % maxCrumbs] = pos;
+        else { ring[head] = pos; head = (head + 1) % maxCrumbs; }
     }
 }
 
 void Breadcrumb::draw(sf::RenderWindow &win) {
-    std::queue<sf::Vector2f> temp = q;
+    if (count == 0) return;
+    mesh.resize(static_cast<std::size_t>(count) * 24);
     float alpha = 50.f;
     float inc = 200.f / std::max(1, maxCrumbs);
-    while (!temp.empty()) {
-        sf::CircleShape c(3.f);
-        c.setPosition(temp.front() - sf::Vector2f(3.f,3.f));
+    std::size_t v = 0;
+    for (int i = 0; i < count; ++i) {
         sf::Color col = color;
         col.a = static_cast<std::uint8_t>(std::min(255.f, alpha));
-        c.setFillColor(col);
-        win.draw(c);
-        temp.pop();
+        appendDot(mesh, v, ring[(head + i) % maxCrumbs], 3.f, col);
         alpha += inc;
     }
+    win.draw(mesh);
 }
 
 void Breadcrumb::clear() {
-    while (!q.empty()) q.pop();
+    head = count = 0;
     counter = 0;
 }
 
@@ -214,12 +218,31 @@ SteeringOutput WallAvoidance::calculateSteering(const Kinematic &c, const Kinema
     return out;
 }
 
+// FixedTimestep
+int FixedTimestep::advance(float frameTime) {
+    accumulator += frameTime;
+    int steps = 0;
+    while (accumulator >= dt && steps < maxSubsteps) { accumulator -= dt; ++steps; }
+    if (accumulator >= dt) accumulator = std::fmod(accumulator, dt); // spiral of death guard
+    return steps;
+}
+
+Kinematic interpolate(const Kinematic &from, const Kinematic &to, float alpha) {
+    Kinematic k = to;
+    sf::Vector2f d = to.position - from.position;
+    if (std::abs(d.x) > WINDOW_WIDTH / 2.f || std::abs(d.y) > WINDOW_HEIGHT / 2.f) return k;
+    k.position = from.position + d * alpha;
+    k.orientation = mapToRange(from.orientation + mapToRange(to.orientation - from.orientation) * alpha);
+    return k;
+}
+
 // Character
 Character::Character(sf::Vector2f start, sf::Color color)
     : breadcrumbs(20, 10, color), currentBehavior(nullptr), maxSpeed(400.f), maxRotation(5.f), currentWaypoint(0) { // 2x speed
     kinematic.position = start;
     kinematic.velocity = sf::Vector2f(randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f));
     kinematic.orientation = std::atan2(kinematic.velocity.y, kinematic.velocity.x);
+    previous = kinematic;
 
     shape = sf::CircleShape(10.f); // Simple circle agent
     shape.setFillColor(color);
@@ -230,9 +253,10 @@ void Character::setBehavior(SteeringBehavior *b) { currentBehavior = b; }
 Kinematic &Character::getKinematic() { return kinematic; }
 void Character::clearBreadcrumbs() { breadcrumbs.clear(); }
 void Character::setMaxSpeed(float s) { maxSpeed = s; }
-void Character::setPosition(sf::Vector2f p) { kinematic.position = p; shape.setPosition(p); }
+void Character::setPosition(sf::Vector2f p) { kinematic.position = p; previous = kinematic; }
 
 void Character::update(float dt, const Kinematic & /*dummyTarget*/) {
+    previous = kinematic;
     Kinematic target = kinematic; // Default to self if no path/behavior
     bool usingPath = !currentPath.empty();
     if (usingPath) {
@@ -283,8 +307,6 @@ void Character::update(float dt, const Kinematic & /*dummyTarget*/) {
 
     kinematic.orientation = mapToRange(kinematic.orientation);
     breadcrumbs.update(kinematic.position);
-    shape.setPosition(kinematic.position);
-    shape.setRotation(sf::degrees(kinematic.orientation * 180.f / PI));
 }
 
 void Character::updateWithBoundaryHandling(float dt, const Kinematic &target) {
@@ -296,7 +318,10 @@ void Character::updateWithBoundaryHandling(float dt, const Kinematic &target) {
     if (kinematic.position.y > WINDOW_HEIGHT - margin) { kinematic.position.y = WINDOW_HEIGHT - margin; kinematic.velocity.y = -std::abs(kinematic.velocity.y) * 0.8f; }
 }
 
-void Character::draw(sf::RenderWindow &win) {
+void Character::draw(sf::RenderWindow &win, float alpha) {
+    Kinematic pose = interpolate(previous, kinematic, alpha);
+    shape.setPosition(pose.position);
+    shape.setRotation(sf::degrees(pose.orientation * 180.f / PI));
     breadcrumbs.draw(win);
     win.draw(shape); // Draw circle
 }
@@ -3,10 +3,9 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <queue>
 #include <cmath>
 #include <memory>
-#include <random>
+#include "rng.h"
 #include <algorithm>
 #include <cstdint>
 #include <optional>
@@ -36,13 +35,33 @@ struct SteeringOutput {
 };
 
 // ---------------------------------------------------------------------
-// Breadcrumbs
+// Fixed timestep: advance() turns real frame time into a number of dt ticks
+// (at most maxSubsteps, the rest of a long frame is dropped), alpha() is how
+// far rendering sits between the last two ticks
+struct FixedTimestep {
+    float dt;
+    int maxSubsteps;
+    float accumulator = 0.f;
+
+    explicit FixedTimestep(float hz = 60.f, int maxSteps = 5) : dt(1.f / hz), maxSubsteps(maxSteps) {}
+    int advance(float frameTime);
+    float alpha() const { return accumulator / dt; }
+};
+
+// Render pose between two ticks; jumps over half the window are not blended
+Kinematic interpolate(const Kinematic &from, const Kinematic &to, float alpha);
+
+// ---------------------------------------------------------------------
+// Breadcrumbs (ring buffer, drawn with a single vertex array)
 class Breadcrumb {
-    std::queue<sf::Vector2f> q;
+    std::vector<sf::Vector2f> ring; // fixed capacity maxCrumbs, oldest at head
+    int head;
+    int count;
     int maxCrumbs;
     int dropInterval;
     int counter;
     sf::Color color;
+    sf::VertexArray mesh; // reused every draw, one octagon per crumb
 public:
     Breadcrumb(int maxCrumbs_=30, int dropInterval_=5, sf::Color c=sf::Color::Blue);
     void update(const sf::Vector2f &pos);
@@ -179,6 +198,7 @@ public:
 // Character
 class Character {
     Kinematic kinematic;
+    Kinematic previous; // before the last update, for interpolated drawing
     Breadcrumb breadcrumbs;
     sf::CircleShape shape;
     SteeringBehavior *currentBehavior;
@@ -195,7 +215,7 @@ public:
     void setPosition(sf::Vector2f p);
     void update(float dt, const Kinematic &target);
     void updateWithBoundaryHandling(float dt, const Kinematic &target);
-    void draw(sf::RenderWindow &win);
+    void draw(sf::RenderWindow &win, float alpha = 1.f); // alpha 0 = previous tick, 1 = current
     void setPath(const std::vector<sf::Vector2f>& path);
 };
 
@@ -0,0 +1,51 @@
+#pragma once
+#include "Graph.h"
+#include "Pathfinder.h"
+#include "SearchContext.h"
+#include <string>
+#include <vector>
+
+// Upward / downward arcs of the hierarchy in CSR form. middle[i] is the node a
+// shortcut bypasses (-1 for an original edge) and is used to unpack paths.
+struct CHAdjacency : CSRAdjacency {
+    std::vector<int> middle;
+};
+
+// Contraction Hierarchies for graphs whose topology no longer changes.
+// build() contracts nodes in edge-difference order (lazy updates), adding a
+// shortcut u -> w whenever a local witness search finds no path avoiding v
+// that is at least as short as u -> v -> w. Queries run a bidirectional
+// Dijkstra that only climbs in rank, then unpack shortcuts back to the
+// original node ids. After build() or load() the graph itself is not needed.
+class ContractionHierarchy {
+public:
+    ContractionHierarchy() = default;
+
+    void build(const Graph &g);
+
+    // Binary file with the node order and both arc sets; false on I/O errors
+    bool save(const std::string &path) const;
+    bool load(const std::string &path);
+
+    bool empty() const { return m_rank.empty(); }
+    int numNodes() const { return (int)m_rank.size(); }
+    long numShortcuts() const { return m_numShortcuts; }
+
+    // Same fields as the Pathfinder searches; exploredCount counts both sides
+    PathResult query(int start, int goal);
+
+private:
+    // Arcs are stored in rank space (row r belongs to node m_order[r]) so the
+    // top of the hierarchy, which every query touches, is contiguous in memory
+    std::vector<int> m_rank;  // node -> contraction order, higher = more important
+    std::vector<int> m_order; // rank -> node
+    CHAdjacency m_up;         // at r: arcs r -> s with s > r
+    CHAdjacency m_down;       // at r: arcs s -> r with s > r (to[] holds s)
+    long m_numShortcuts = 0;
+
+    SearchContext m_fwd, m_bwd;
+
+    // Appends the original arcs of a -> b (ranks, excluding a) to out
+    void unpack(int a, int b, std::vector<int> &out) const;
+    int middleOf(int a, int b) const; // bypassed rank of arc a -> b, -1 if original
+};
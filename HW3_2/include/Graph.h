@@ -18,6 +18,28 @@ struct Node {
         id(id_), x(x_), y(y_), label(label_) {}
 };
 
+// Frozen compressed-sparse-row adjacency (SoA): out-edges of u occupy
+// [offsets[u], offsets[u+1]) in the contiguous to / weight arrays.
+struct CSRAdjacency {
+    std::vector<int> offsets;
+    std::vector<int> to;
+    std::vector<double> weight;
+
+    bool empty() const { return offsets.empty(); }
+};
+
+// Calls fn(v, weight) for each out-edge of u; overloaded per layout so the
+// search code can be templated over either representation.
+template <class Fn>
+inline void forEachEdge(const std::vector<std::vector<Edge>> &adj, int u, Fn &&fn) {
+    for (const Edge &e : adj[u]) fn(e.to, e.weight);
+}
+
+template <class Fn>
+inline void forEachEdge(const CSRAdjacency &csr, int u, Fn &&fn) {
+    for (int i = csr.offsets[u], end = csr.offsets[u + 1]; i < end; ++i) fn(csr.to[i], csr.weight[i]);
+}
+
 class Graph {
 public:
     Graph() = default;
@@ -28,9 +50,16 @@ public:
     // add directed edge from u -> v with positive weight
     void addEdge(int u, int v, double weight);
 
+    // freeze the adjacency lists into CSR form (plus a reversed copy for backward
+    // searches); addNode/addEdge afterwards drop both again
+    void finalize();
+    bool isFinalized() const { return !m_csr.empty(); }
+
     // accessors
     const std::vector<Node>& nodes() const { return m_nodes; }
     const std::vector<std::vector<Edge>>& adj() const { return m_adj; }
+    const CSRAdjacency& csr() const { return m_csr; }
+    const CSRAdjacency& reverseCsr() const { return m_rcsr; } // in-edges: to[] holds the source
 
     int numNodes() const { return (int)m_nodes.size(); }
     void clear();
@@ -45,4 +74,6 @@ public:
 private:
     std::vector<Node> m_nodes;
     std::vector<std::vector<Edge>> m_adj;
+    CSRAdjacency m_csr;
+    CSRAdjacency m_rcsr;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "Graph.h"
+#include "SearchContext.h"
 #include <vector>
 #include <functional>
 #include <optional>
@@ -25,6 +26,18 @@ public:
     // A* with heuristic function (heuristic(start, goal) should be admissible for correct A*)
     PathResult astar(int start, int goal, HeuristicFn heuristic);
 
+    // Same as above, but using caller-owned scratch (e.g. one context per thread)
+    PathResult astar(int start, int goal, HeuristicFn heuristic, SearchContext &ctx);
+
+    // Bidirectional variants: a backward search from goal over the reverse edges
+    // meets the forward one; exploredCount / maxFringeSize cover both sides.
+    // The A* version averages the two potentials, so heuristic(a,b) must be a
+    // consistent lower bound when used from the start side too (heuristic(start, v)).
+    PathResult bidirectionalDijkstra(int start, int goal);
+    PathResult bidirectionalAstar(int start, int goal, HeuristicFn heuristic);
+
 private:
     const Graph &m_g;
+    SearchContext m_ctx;     // reused by every query made through this Pathfinder
+    SearchContext m_ctxBack; // backward side of the bidirectional searches
 };
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Reusable per-query scratch (g-scores, parents, closed flags).
+// Arrays are kept alive across searches; begin() invalidates them in O(1)
+// with a generation counter instead of refilling them with infinity.
+class SearchContext {
+public:
+    void begin(int n) {
+        if ((int)m_gscore.size() != n) {
+            m_gscore.assign(n, 0.0);
+            m_parent.assign(n, -1);
+            m_seen.assign(n, 0);
+            m_closed.assign(n, 0);
+            m_generation = 1;
+            return;
+        }
+        if (++m_generation == 0) { // counter wrapped; clear stamps once
+            std::fill(m_seen.begin(), m_seen.end(), 0u);
+            std::fill(m_closed.begin(), m_closed.end(), 0u);
+            m_generation = 1;
+        }
+    }
+
+    bool seen(int v) const { return m_seen[v] == m_generation; }
+    bool closed(int v) const { return m_closed[v] == m_generation; }
+    void close(int v) { m_closed[v] = m_generation; }
+
+    double g(int v) const { return seen(v) ? m_gscore[v] : std::numeric_limits<double>::infinity(); }
+    int parent(int v) const { return seen(v) ? m_parent[v] : -1; }
+
+    void relax(int v, double g, int parent) {
+        m_gscore[v] = g;
+        m_parent[v] = parent;
+        m_seen[v] = m_generation;
+    }
+
+private:
+    std::vector<double> m_gscore;
+    std::vector<int> m_parent;
+    std::vector<std::uint32_t> m_seen;
+    std::vector<std::uint32_t> m_closed;
+    std::uint32_t m_generation = 0;
+};
@@ -0,0 +1,404 @@
+#include "ContractionHierarchy.h"
+#include <queue>
+#include <limits>
+#include <chrono>
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+
+using clk = std::chrono::high_resolution_clock;
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+// Witness searches give up after this many settled nodes. Stopping early only
+// adds a few unnecessary shortcuts, never wrong ones.
+const int SIMULATE_SETTLE_LIMIT = 60;
+const int CONTRACT_SETTLE_LIMIT = 500;
+
+struct WorkArc {
+    int to;
+    double weight;
+    int middle;
+};
+
+struct Shortcut {
+    int from, to;
+    double weight;
+};
+
+using QItem = std::pair<double, int>; // key, node
+using MinQueue = std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>>;
+
+// Mutable overlay graph used while contracting: only uncontracted nodes keep
+// arcs, so everything left in out/in points to a node of higher rank.
+class Contractor {
+public:
+    explicit Contractor(const Graph &g)
+        : m_n(g.numNodes()), m_out(m_n), m_in(m_n), m_deleted(m_n, 0), m_level(m_n, 0), m_up(m_n), m_down(m_n),
+          m_targetStamp(m_n, 0) {
+        for (int u = 0; u < m_n; ++u)
+            for (const Edge &e : g.adj()[u])
+                if (e.to != u) addArc(u, e.to, e.weight, -1);
+    }
+
+    int priority(int v) {
+        int shortcuts = findShortcuts(v, SIMULATE_SETTLE_LIMIT, nullptr);
+        int edgeDifference = shortcuts - (int)(m_out[v].size() + m_in[v].size());
+        return 2 * edgeDifference + m_deleted[v] + m_level[v];
+    }
+
+    // Records v's remaining arcs as its hierarchy arcs, detaches v and adds
+    // the shortcuts that keep distances between its neighbours intact
+    long contract(int v) {
+        std::vector<Shortcut> shortcuts;
+        findShortcuts(v, CONTRACT_SETTLE_LIMIT, &shortcuts);
+
+        m_up[v] = m_out[v];
+        m_down[v] = m_in[v];
+        auto retire = [&](int x) {
+            m_deleted[x]++;
+            m_level[x] = std::max(m_level[x], m_level[v] + 1);
+        };
+        for (const WorkArc &a : m_out[v]) { detach(m_in[a.to], v); retire(a.to); }
+        for (const WorkArc &a : m_in[v]) { detach(m_out[a.to], v); retire(a.to); }
+        m_out[v].clear();
+        m_in[v].clear();
+
+        long added = 0;
+        for (const Shortcut &s : shortcuts) added += addArc(s.from, s.to, s.weight, v) ? 1 : 0;
+        return added;
+    }
+
+    const std::vector<std::vector<WorkArc>> &up() const { return m_up; }
+    const std::vector<std::vector<WorkArc>> &down() const { return m_down; }
+
+private:
+    int m_n;
+    std::vector<std::vector<WorkArc>> m_out, m_in;
+    std::vector<int> m_deleted; // contracted neighbours, spreads contraction evenly
+    std::vector<int> m_level;   // depth in the hierarchy so far, keeps it shallow
+    std::vector<std::vector<WorkArc>> m_up, m_down;
+    SearchContext m_ctx;
+    std::vector<QItem> m_heap;          // witness search queue, kept between searches
+    std::vector<unsigned> m_targetStamp; // == m_targetGen for the current out-neighbours
+    unsigned m_targetGen = 0;
+
+    // Inserts u -> w or lowers an existing arc; false if the old arc was as short
+    bool addArc(int u, int w, double weight, int middle) {
+        for (WorkArc &a : m_out[u]) {
+            if (a.to != w) continue;
+            if (a.weight <= weight) return false;
+            a.weight = weight;
+            a.middle = middle;
+            for (WorkArc &b : m_in[w]) {
+                if (b.to == u) { b.weight = weight; b.middle = middle; break; }
+            }
+            return true;
+        }
+        m_out[u].push_back({w, weight, middle});
+        m_in[w].push_back({u, weight, middle});
+        return true;
+    }
+
+    static void detach(std::vector<WorkArc> &arcs, int v) {
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (arcs[i].to == v) { arcs[i] = arcs.back(); arcs.pop_back(); return; }
+        }
+    }
+
+    // Dijkstra from source that never enters avoid. Stops once every node marked
+    // as a target is settled, past maxDist, or after settleLimit nodes.
+    void witnessSearch(int source, int avoid, double maxDist, int settleLimit, int targets) {
+        m_ctx.begin(m_n);
+        m_heap.clear();
+        m_ctx.relax(source, 0.0, -1);
+        m_heap.push_back({0.0, source});
+        int settled = 0;
+        while (!m_heap.empty() && targets > 0) {
+            std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<QItem>());
+            double d = m_heap.back().first;
+            int u = m_heap.back().second;
+            m_heap.pop_back();
+            if (m_ctx.closed(u)) continue;
+            if (d > maxDist || ++settled > settleLimit) break;
+            m_ctx.close(u);
+            if (m_targetStamp[u] == m_targetGen) --targets;
+            for (const WorkArc &a : m_out[u]) {
+                if (a.to == avoid) continue;
+                if (d + a.weight < m_ctx.g(a.to)) {
+                    m_ctx.relax(a.to, d + a.weight, u);
+                    m_heap.push_back({d + a.weight, a.to});
+                    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<QItem>());
+                }
+            }
+        }
+    }
+
+    // Counts (and optionally collects) the shortcuts contracting v would need
+    int findShortcuts(int v, int settleLimit, std::vector<Shortcut> *out) {
+        if (m_in[v].empty() || m_out[v].empty()) return 0;
+        double maxOut = 0.0;
+        for (const WorkArc &a : m_out[v]) maxOut = std::max(maxOut, a.weight);
+
+        ++m_targetGen;
+        for (const WorkArc &a : m_out[v]) m_targetStamp[a.to] = m_targetGen;
+
+        int count = 0;
+        for (const WorkArc &in : m_in[v]) {
+            // in.to itself is never a shortcut target, so it does not count
+            int targets = (int)m_out[v].size() - (m_targetStamp[in.to] == m_targetGen ? 1 : 0);
+            witnessSearch(in.to, v, in.weight + maxOut, settleLimit, targets);
+            for (const WorkArc &o : m_out[v]) {
+                if (o.to == in.to) continue;
+                double via = in.weight + o.weight;
+                if (m_ctx.g(o.to) > via) {
+                    ++count;
+                    if (out) out->push_back({in.to, o.to, via});
+                }
+            }
+        }
+        return count;
+    }
+};
+
+// Flattens per-node arc lists into rank-space CSR
+void flatten(const std::vector<std::vector<WorkArc>> &lists, const std::vector<int> &rank,
+             const std::vector<int> &order, CHAdjacency &csr) {
+    const int n = (int)lists.size();
+    csr.offsets.assign(n + 1, 0);
+    for (int r = 0; r < n; ++r) csr.offsets[r + 1] = csr.offsets[r] + (int)lists[order[r]].size();
+    csr.to.resize(csr.offsets.back());
+    csr.weight.resize(csr.offsets.back());
+    csr.middle.resize(csr.offsets.back());
+    for (int r = 0; r < n; ++r) {
+        int i = csr.offsets[r];
+        for (const WorkArc &a : lists[order[r]]) {
+            csr.to[i] = rank[a.to];
+            csr.weight[i] = a.weight;
+            csr.middle[i] = a.middle == -1 ? -1 : rank[a.middle];
+            ++i;
+        }
+    }
+}
+
+// --- Binary I/O: every array is written as a uint64 count followed by raw data ---
+
+const std::uint32_t CH_MAGIC = 0x31304843; // "CH01"
+
+template <class T>
+void writeVec(std::ofstream &out, const std::vector<T> &v) {
+    std::uint64_t size = v.size();
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char *>(v.data()), (std::streamsize)(v.size() * sizeof(T)));
+}
+
+template <class T>
+bool readVec(std::ifstream &in, std::vector<T> &v) {
+    std::uint64_t size = 0;
+    if (!in.read(reinterpret_cast<char *>(&size), sizeof(size))) return false;
+    if (size > (1ull << 34) / sizeof(T)) return false; // corrupt header
+    v.resize(size);
+    return (bool)in.read(reinterpret_cast<char *>(v.data()), (std::streamsize)(size * sizeof(T)));
+}
+
+void writeArcs(std::ofstream &out, const CHAdjacency &a) {
+    writeVec(out, a.offsets);
+    writeVec(out, a.to);
+    writeVec(out, a.weight);
+    writeVec(out, a.middle);
+}
+
+bool readArcs(std::ifstream &in, CHAdjacency &a, int n) {
+    if (!readVec(in, a.offsets) || !readVec(in, a.to) || !readVec(in, a.weight) || !readVec(in, a.middle)) return false;
+    if ((int)a.offsets.size() != n + 1 || a.offsets.front() != 0) return false;
+    const size_t m = (size_t)a.offsets.back();
+    return a.to.size() == m && a.weight.size() == m && a.middle.size() == m;
+}
+
+} // namespace
+
+void ContractionHierarchy::build(const Graph &g) {
+    const int n = g.numNodes();
+    Contractor work(g);
+
+    MinQueue order; // (edge difference, node), updated lazily
+    for (int v = 0; v < n; ++v) order.push({(double)work.priority(v), v});
+
+    m_rank.assign(n, -1);
+    m_numShortcuts = 0;
+    int next = 0;
+    while (!order.empty()) {
+        int v = order.top().second;
+        order.pop();
+        // Priorities go stale as neighbours get contracted; if v is no longer
+        // the cheapest, put it back with its fresh value
+        double fresh = work.priority(v);
+        if (!order.empty() && fresh > order.top().first) {
+            order.push({fresh, v});
+            continue;
+        }
+        m_rank[v] = next++;
+        m_numShortcuts += work.contract(v);
+    }
+
+    m_order.assign(n, 0);
+    for (int v = 0; v < n; ++v) m_order[m_rank[v]] = v;
+    flatten(work.up(), m_rank, m_order, m_up);
+    flatten(work.down(), m_rank, m_order, m_down);
+}
+
+bool ContractionHierarchy::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    std::int32_t n = numNodes();
+    std::int64_t shortcuts = m_numShortcuts;
+    out.write(reinterpret_cast<const char *>(&CH_MAGIC), sizeof(CH_MAGIC));
+    out.write(reinterpret_cast<const char *>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char *>(&shortcuts), sizeof(shortcuts));
+    writeVec(out, m_rank);
+    writeArcs(out, m_up);
+    writeArcs(out, m_down);
+    return (bool)out;
+}
+
+bool ContractionHierarchy::load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::uint32_t magic = 0;
+    std::int32_t n = 0;
+    std::int64_t shortcuts = 0;
+    in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char *>(&n), sizeof(n));
+    in.read(reinterpret_cast<char *>(&shortcuts), sizeof(shortcuts));
+    if (!in || magic != CH_MAGIC || n < 0) return false;
+
+    ContractionHierarchy loaded;
+    if (!readVec(in, loaded.m_rank) || (int)loaded.m_rank.size() != n) return false;
+    if (!readArcs(in, loaded.m_up, n) || !readArcs(in, loaded.m_down, n)) return false;
+
+    loaded.m_order.assign(n, -1);
+    for (int v = 0; v < n; ++v) {
+        int r = loaded.m_rank[v];
+        if (r < 0 || r >= n || loaded.m_order[r] != -1) return false; // not a permutation
+        loaded.m_order[r] = v;
+    }
+
+    m_rank = std::move(loaded.m_rank);
+    m_order = std::move(loaded.m_order);
+    m_up = std::move(loaded.m_up);
+    m_down = std::move(loaded.m_down);
+    m_numShortcuts = shortcuts;
+    return true;
+}
+
+int ContractionHierarchy::middleOf(int a, int b) const {
+    // Every arc is stored once, at its lower-ranked end
+    const bool upward = a < b;
+    const CHAdjacency &arcs = upward ? m_up : m_down;
+    const int at = upward ? a : b, other = upward ? b : a;
+    for (int i = arcs.offsets[at]; i < arcs.offsets[at + 1]; ++i) {
+        if (arcs.to[i] == other) return arcs.middle[i];
+    }
+    return -1;
+}
+
+void ContractionHierarchy::unpack(int a, int b, std::vector<int> &out) const {
+    std::vector<std::pair<int, int>> stack{{a, b}};
+    while (!stack.empty()) {
+        auto [u, v] = stack.back();
+        stack.pop_back();
+        int m = middleOf(u, v);
+        if (m == -1) {
+            out.push_back(v);
+            continue;
+        }
+        stack.push_back({m, v}); // u -> m is unpacked first
+        stack.push_back({u, m});
+    }
+}
+
+PathResult ContractionHierarchy::query(int start, int goal) {
+    PathResult res;
+    res.found = false;
+    res.cost = INF;
+    res.exploredCount = 0;
+    res.maxFringeSize = 0;
+    res.runtimeMs = 0.0;
+
+    const int n = numNodes();
+    if (start < 0 || start >= n || goal < 0 || goal >= n) return res;
+
+    auto t0 = clk::now();
+
+    SearchContext *ctx[2] = {&m_fwd, &m_bwd};
+    const CHAdjacency *climb[2] = {&m_up, &m_down}; // arcs each side relaxes
+    const CHAdjacency *stall[2] = {&m_down, &m_up}; // arcs from higher nodes into u
+    MinQueue open[2];
+    m_fwd.begin(n);
+    m_bwd.begin(n);
+    const int s = m_rank[start], t = m_rank[goal];
+    m_fwd.relax(s, 0.0, -1);
+    m_bwd.relax(t, 0.0, -1);
+    open[0].push({0.0, s});
+    open[1].push({0.0, t});
+
+    double mu = INF;
+    int meet = -1;
+
+    // Both sides only climb, so neither can stop at the first meeting; each
+    // runs until its own minimum reaches mu
+    auto active = [&](int side) { return !open[side].empty() && open[side].top().first < mu; };
+    while (active(0) || active(1)) {
+        res.maxFringeSize = std::max(res.maxFringeSize, (long)(open[0].size() + open[1].size()));
+        int side = !active(1) || (active(0) && open[0].top().first <= open[1].top().first) ? 0 : 1;
+        SearchContext &mine = *ctx[side];
+        const SearchContext &other = *ctx[1 - side];
+        double d = open[side].top().first;
+        int u = open[side].top().second;
+        open[side].pop();
+        if (mine.closed(u)) continue;
+        mine.close(u);
+        res.exploredCount++;
+
+        if (d + other.g(u) < mu) {
+            mu = d + other.g(u);
+            meet = u;
+        }
+
+        // Stall-on-demand: a higher node already reaches u more cheaply, so
+        // d is not u's true distance and nothing useful climbs from here
+        const CHAdjacency &in = *stall[side];
+        bool stalled = false;
+        for (int i = in.offsets[u]; i < in.offsets[u + 1] && !stalled; ++i)
+            stalled = mine.g(in.to[i]) + in.weight[i] < d;
+        if (stalled) continue;
+
+        forEachEdge(*climb[side], u, [&](int v, double w) {
+            if (d + w < mine.g(v)) {
+                mine.relax(v, d + w, u);
+                open[side].push({d + w, v});
+            }
+        });
+    }
+
+    if (meet != -1) {
+        std::vector<int> up; // s ... meet
+        for (int v = meet; v != -1; v = m_fwd.parent(v)) up.push_back(v);
+        std::reverse(up.begin(), up.end());
+
+        std::vector<int> path{s};
+        for (size_t i = 1; i < up.size(); ++i) unpack(up[i - 1], up[i], path);
+        for (int v = meet; m_bwd.parent(v) != -1; v = m_bwd.parent(v)) unpack(v, m_bwd.parent(v), path);
+        for (int &v : path) v = m_order[v]; // back to node ids
+
+        res.found = true;
+        res.path = std::move(path);
+        res.cost = mu;
+    }
+
+    auto t1 = clk::now();
+    res.runtimeMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    return res;
+}
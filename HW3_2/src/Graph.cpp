@@ -0,0 +1,182 @@
+#include "Graph.h"
+#include <cmath>
+#include <random>
+#include <queue>
+#include <algorithm>
+
+int Graph::addNode(double x, double y, const std::string &label) {
+    int id = (int)m_nodes.size();
+    m_nodes.emplace_back(id, x, y, label);
+    m_adj.emplace_back();
+    m_csr = CSRAdjacency{}; // topology changed, CSR is stale
+    m_rcsr = CSRAdjacency{};
+    return id;
+}
+
+void Graph::addEdge(int u, int v, double weight) {
+    if (u < 0 || u >= numNodes() || v < 0 || v >= numNodes()) return;
+    m_adj[u].emplace_back(v, weight);
+    if (isFinalized()) {
+        m_csr = CSRAdjacency{};
+        m_rcsr = CSRAdjacency{};
+    }
+}
+
+void Graph::finalize() {
+    const int n = numNodes();
+    m_csr.offsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u) m_csr.offsets[u + 1] = m_csr.offsets[u] + (int)m_adj[u].size();
+
+    m_csr.to.resize(m_csr.offsets.back());
+    m_csr.weight.resize(m_csr.offsets.back());
+    for (int u = 0; u < n; ++u) {
+        int i = m_csr.offsets[u];
+        for (const Edge &e : m_adj[u]) {
+            m_csr.to[i] = e.to;
+            m_csr.weight[i] = e.weight;
+            ++i;
+        }
+    }
+
+    // Reverse: bucket every edge u -> v under v
+    m_rcsr.offsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u)
+        for (const Edge &e : m_adj[u]) m_rcsr.offsets[e.to + 1]++;
+    for (int v = 0; v < n; ++v) m_rcsr.offsets[v + 1] += m_rcsr.offsets[v];
+
+    m_rcsr.to.resize(m_rcsr.offsets.back());
+    m_rcsr.weight.resize(m_rcsr.offsets.back());
+    std::vector<int> fill(m_rcsr.offsets.begin(), m_rcsr.offsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (const Edge &e : m_adj[u]) {
+            m_rcsr.to[fill[e.to]] = u;
+            m_rcsr.weight[fill[e.to]] = e.weight;
+            ++fill[e.to];
+        }
+    }
+}
+
+void Graph::clear() {
+    m_nodes.clear();
+    m_adj.clear();
+    m_csr = CSRAdjacency{};
+    m_rcsr = CSRAdjacency{};
+}
+
+Graph Graph::makeSampleGraph() {
+    // 6 x 5 grid of intersections with slightly irregular spacing, streets in
+    // both directions, a few missing blocks and two diagonal avenues.
+    Graph g;
+    const int cols = 6, rows = 5;
+    const double jitter[rows][cols] = {
+        { 0,  8, -6,  4, -3,  5},
+        {-5,  3,  7, -8,  2, -4},
+        { 6, -2, -5,  3,  8, -7},
+        {-3,  7,  2, -6, -4,  3},
+        { 4, -6,  5,  2, -5,  0}
+    };
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            std::string label = std::string(1, (char)('A' + r)) + std::to_string(c + 1);
+            g.addNode(c * 100.0 + jitter[r][c], r * 80.0 - jitter[rows - 1 - r][c], label);
+        }
+    }
+
+    auto id = [cols](int r, int c) { return r * cols + c; };
+    auto road = [&g](int u, int v) {
+        const Node &a = g.m_nodes[u];
+        const Node &b = g.m_nodes[v];
+        double w = std::hypot(a.x - b.x, a.y - b.y);
+        g.addEdge(u, v, w);
+        g.addEdge(v, u, w);
+    };
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            bool closedEast = (r == 1 && c == 2) || (r == 3 && c == 0) || (r == 2 && c == 4);
+            bool closedSouth = (r == 0 && c == 3) || (r == 2 && c == 1) || (r == 3 && c == 5);
+            if (c + 1 < cols && !closedEast) road(id(r, c), id(r, c + 1));
+            if (r + 1 < rows && !closedSouth) road(id(r, c), id(r + 1, c));
+        }
+    }
+
+    // Diagonal avenues
+    road(id(0, 0), id(1, 1));
+    road(id(1, 1), id(2, 2));
+    road(id(2, 2), id(3, 3));
+    road(id(4, 1), id(3, 2));
+    road(id(3, 2), id(2, 3));
+    road(id(2, 3), id(1, 4));
+
+    g.finalize();
+    return g;
+}
+
+Graph Graph::makeRandomLargeGraph(int N, int k, unsigned seed) {
+    Graph g;
+    if (N <= 0) return g;
+
+    // Points uniform in a square whose side grows with sqrt(N), so density
+    // (and therefore typical edge length) stays the same for any N.
+    const double side = std::sqrt((double)N) * 10.0;
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coord(0.0, side);
+    for (int i = 0; i < N; ++i) g.addNode(coord(gen), coord(gen));
+
+    // Bucket points into a uniform grid (~2 per cell) for the kNN queries
+    const int cells = std::max(1, (int)std::ceil(std::sqrt(N / 2.0)));
+    const double cellSize = side / cells;
+    auto cellOf = [&](double v) { return std::min(cells - 1, (int)(v / cellSize)); };
+
+    std::vector<int> cellStart(cells * cells + 1, 0);
+    std::vector<int> sorted(N);
+    for (const Node &n : g.m_nodes) cellStart[cellOf(n.y) * cells + cellOf(n.x) + 1]++;
+    for (int c = 0; c < cells * cells; ++c) cellStart[c + 1] += cellStart[c];
+    {
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (const Node &n : g.m_nodes) sorted[fill[cellOf(n.y) * cells + cellOf(n.x)]++] = n.id;
+    }
+
+    using Cand = std::pair<double, int>; // dist, node (max-heap keeps k best)
+    std::vector<Cand> best;
+    for (int u = 0; u < N; ++u) {
+        const Node &nu = g.m_nodes[u];
+        const int cx = cellOf(nu.x), cy = cellOf(nu.y);
+        std::priority_queue<Cand> heap;
+
+        for (int ring = 0; ring < cells; ++ring) {
+            for (int y = cy - ring; y <= cy + ring; ++y) {
+                if (y < 0 || y >= cells) continue;
+                bool edgeRow = (y == cy - ring || y == cy + ring);
+                for (int x = cx - ring; x <= cx + ring; x += (edgeRow || ring == 0) ? 1 : 2 * ring) {
+                    if (x < 0 || x >= cells) continue;
+                    int c = y * cells + x;
+                    for (int i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+                        int v = sorted[i];
+                        if (v == u) continue;
+                        const Node &nv = g.m_nodes[v];
+                        double d = std::hypot(nu.x - nv.x, nu.y - nv.y);
+                        if ((int)heap.size() < k) heap.push({d, v});
+                        else if (d < heap.top().first) { heap.pop(); heap.push({d, v}); }
+                    }
+                }
+            }
+            // Anything in the next ring is at least ring * cellSize away
+            if ((int)heap.size() == k && heap.top().first <= ring * cellSize) break;
+        }
+
+        best.clear();
+        while (!heap.empty()) { best.push_back(heap.top()); heap.pop(); }
+        for (const auto &[d, v] : best) {
+            // undirected k-NN: add both directions once
+            bool exists = false;
+            for (const Edge &e : g.m_adj[u]) if (e.to == v) { exists = true; break; }
+            if (exists) continue;
+            g.addEdge(u, v, d);
+            g.addEdge(v, u, d);
+        }
+    }
+
+    g.finalize();
+    return g;
+}
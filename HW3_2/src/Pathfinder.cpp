@@ -5,6 +5,7 @@
 #include <iostream>
 #include <cmath>
 #include <unordered_set>
+#include <algorithm>
 
 using clk = std::chrono::high_resolution_clock;
 
@@ -20,11 +21,18 @@ struct PQItem {
 Pathfinder::Pathfinder(const Graph &g): m_g(g) {}
 
 PathResult Pathfinder::dijkstra(int start, int goal) {
-    auto zero = [](int a,int b){ return 0.0; };
+    auto zero = [](int,int){ return 0.0; };
     return astar(start, goal, zero);
 }
 
 PathResult Pathfinder::astar(int start, int goal, HeuristicFn heuristic) {
+    return astar(start, goal, heuristic, m_ctx);
+}
+
+// A* body, templated over the adjacency layout (adjacency lists or frozen CSR)
+template <class Adjacency>
+static PathResult runAStar(const Graph &graph, const Adjacency &adj, int start, int goal,
+                           const Pathfinder::HeuristicFn &heuristic, SearchContext &ctx) {
     PathResult res;
     res.found = false;
     res.cost = std::numeric_limits<double>::infinity();
@@ -32,17 +40,14 @@ PathResult Pathfinder::astar(int start, int goal, HeuristicFn heuristic) {
     res.maxFringeSize = 0;
     res.runtimeMs = 0.0;
 
-    if (start < 0 || start >= m_g.numNodes() || goal < 0 || goal >= m_g.numNodes()) return res;
+    if (start < 0 || start >= graph.numNodes() || goal < 0 || goal >= graph.numNodes()) return res;
 
     auto t0 = clk::now();
 
-    const int n = m_g.numNodes();
-    std::vector<double> gscore(n, std::numeric_limits<double>::infinity());
-    std::vector<int> parent(n, -1);
-    std::vector<char> closed(n, 0);
+    ctx.begin(graph.numNodes());
 
     std::priority_queue<PQItem> open;
-    gscore[start] = 0.0;
+    ctx.relax(start, 0.0, -1);
     open.push(PQItem{start, heuristic(start, goal), 0.0});
 
     while (!open.empty()) {
@@ -50,8 +55,8 @@ PathResult Pathfinder::astar(int start, int goal, HeuristicFn heuristic) {
         PQItem cur = open.top(); open.pop();
         int u = cur.node;
 
-        if (closed[u]) continue; // stale entry
-        closed[u] = 1;
+        if (ctx.closed(u)) continue; // stale entry
+        ctx.close(u);
         res.exploredCount++;
 
         if (u == goal) {
@@ -60,29 +65,27 @@ PathResult Pathfinder::astar(int start, int goal, HeuristicFn heuristic) {
             int curNode = goal;
             while (curNode != -1) {
                 path.push_back(curNode);
-                curNode = parent[curNode];
+                curNode = ctx.parent(curNode);
             }
             std::reverse(path.begin(), path.end());
             res.found = true;
             res.path = std::move(path);
-            res.cost = gscore[goal];
+            res.cost = ctx.g(goal);
             auto t1 = clk::now();
             res.runtimeMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
             return res;
         }
 
         // relax edges
-        const auto &edges = m_g.adj()[u];
-        for (const Edge &e : edges) {
-            int v = e.to;
-            double tentative_g = gscore[u] + e.weight;
-            if (tentative_g < gscore[v]) {
-                gscore[v] = tentative_g;
-                parent[v] = u;
+        const double gu = ctx.g(u);
+        forEachEdge(adj, u, [&](int v, double w) {
+            double tentative_g = gu + w;
+            if (tentative_g < ctx.g(v)) {
+                ctx.relax(v, tentative_g, u);
                 double f = tentative_g + heuristic(v, goal);
                 open.push(PQItem{v, f, tentative_g});
             }
-        }
+        });
     }
 
     // no path
@@ -91,3 +94,110 @@ PathResult Pathfinder::astar(int start, int goal, HeuristicFn heuristic) {
     res.found = false;
     return res;
 }
+
+PathResult Pathfinder::astar(int start, int goal, HeuristicFn heuristic, SearchContext &ctx) {
+    if (m_g.isFinalized()) return runAStar(m_g, m_g.csr(), start, goal, heuristic, ctx);
+    return runAStar(m_g, m_g.adj(), start, goal, heuristic, ctx);
+}
+
+// Bidirectional body. potential(v) is the forward potential pf and the backward
+// side uses -pf, so keys are gF + pf and gR - pf; with pf = 0 this is plain
+// bidirectional Dijkstra. mu is the best meeting path gF(u) + w + gR(v) seen
+// while relaxing, and the search stops once the two queue tops sum to mu.
+template <class Adjacency, class Potential>
+static PathResult runBidirectional(const Graph &graph, const Adjacency &fwd, const Adjacency &rev,
+                                   int start, int goal, const Potential &potential,
+                                   SearchContext &ctxF, SearchContext &ctxB) {
+    PathResult res;
+    res.found = false;
+    res.cost = std::numeric_limits<double>::infinity();
+    res.exploredCount = 0;
+    res.maxFringeSize = 0;
+    res.runtimeMs = 0.0;
+
+    if (start < 0 || start >= graph.numNodes() || goal < 0 || goal >= graph.numNodes()) return res;
+
+    auto t0 = clk::now();
+
+    SearchContext *ctx[2] = {&ctxF, &ctxB};
+    std::priority_queue<PQItem> open[2];
+    ctxF.begin(graph.numNodes());
+    ctxB.begin(graph.numNodes());
+    ctxF.relax(start, 0.0, -1);
+    ctxB.relax(goal, 0.0, -1);
+    open[0].push(PQItem{start, potential(start), 0.0});
+    open[1].push(PQItem{goal, -potential(goal), 0.0});
+
+    double mu = (start == goal) ? 0.0 : std::numeric_limits<double>::infinity();
+    int meetF = start, meetR = goal;
+
+    while (!open[0].empty() && !open[1].empty()) {
+        res.maxFringeSize = std::max(res.maxFringeSize, (long)(open[0].size() + open[1].size()));
+        if (open[0].top().priority + open[1].top().priority >= mu) break;
+
+        int side = open[0].size() <= open[1].size() ? 0 : 1; // grow the smaller frontier
+        SearchContext &mine = *ctx[side];
+        const SearchContext &other = *ctx[1 - side];
+        PQItem cur = open[side].top(); open[side].pop();
+        int u = cur.node;
+
+        if (mine.closed(u)) continue; // stale entry
+        mine.close(u);
+        res.exploredCount++;
+
+        const double gu = mine.g(u);
+        const double sign = side == 0 ? 1.0 : -1.0;
+        auto relax = [&](int v, double w) {
+            double tentative_g = gu + w;
+            if (tentative_g < mine.g(v)) {
+                mine.relax(v, tentative_g, u);
+                open[side].push(PQItem{v, tentative_g + sign * potential(v), tentative_g});
+            }
+            if (tentative_g + other.g(v) < mu) {
+                mu = tentative_g + other.g(v);
+                meetF = side == 0 ? u : v;
+                meetR = side == 0 ? v : u;
+            }
+        };
+        if (side == 0) forEachEdge(fwd, u, relax);
+        else forEachEdge(rev, u, relax);
+    }
+
+    if (mu < std::numeric_limits<double>::infinity()) {
+        std::vector<int> path;
+        for (int cur = meetF; cur != -1; cur = ctxF.parent(cur)) path.push_back(cur);
+        std::reverse(path.begin(), path.end());
+        if (meetR != meetF) {
+            for (int cur = meetR; cur != -1; cur = ctxB.parent(cur)) path.push_back(cur);
+        }
+        res.found = true;
+        res.path = std::move(path);
+        res.cost = mu;
+    }
+
+    auto t1 = clk::now();
+    res.runtimeMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    return res;
+}
+
+template <class Potential>
+static PathResult bidirectionalOn(const Graph &g, int start, int goal, const Potential &potential,
+                                  SearchContext &ctxF, SearchContext &ctxB) {
+    if (g.isFinalized()) return runBidirectional(g, g.csr(), g.reverseCsr(), start, goal, potential, ctxF, ctxB);
+
+    // Not frozen: reverse the adjacency lists for this query
+    std::vector<std::vector<Edge>> rev(g.numNodes());
+    for (int u = 0; u < g.numNodes(); ++u)
+        for (const Edge &e : g.adj()[u]) rev[e.to].emplace_back(u, e.weight);
+    return runBidirectional(g, g.adj(), rev, start, goal, potential, ctxF, ctxB);
+}
+
+PathResult Pathfinder::bidirectionalDijkstra(int start, int goal) {
+    auto zero = [](int) { return 0.0; };
+    return bidirectionalOn(m_g, start, goal, zero, m_ctx, m_ctxBack);
+}
+
+PathResult Pathfinder::bidirectionalAstar(int start, int goal, HeuristicFn heuristic) {
+    auto average = [&](int v) { return 0.5 * (heuristic(v, goal) - heuristic(start, v)); };
+    return bidirectionalOn(m_g, start, goal, average, m_ctx, m_ctxBack);
+}
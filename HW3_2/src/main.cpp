@@ -2,6 +2,7 @@
 #include <iomanip>
 #include "Graph.h"
 #include "Pathfinder.h"
+#include "ContractionHierarchy.h"
 #include <chrono>
 #include <cmath>
 
@@ -23,7 +24,7 @@ static void printResult(const std::string &title, const PathResult &r) {
 }
 
 int main(int argc, char** argv) {
-    std::cout << "Pathfinding demo: Dijkstra and A*\n";
+    std::cout << "Pathfinding demo: Dijkstra and A* (one- and two-sided)\n";
 
     // Create small meaningful graph
     Graph small = Graph::makeSampleGraph();
@@ -88,5 +89,33 @@ int main(int argc, char** argv) {
     auto resLA = pfLarge.astar(sLarge, gLarge, euclidLarge);
     printResult("Large graph - A* (Euclidean)", resLA);
 
+    std::cout << "Running bidirectional Dijkstra on large graph...\n";
+    auto resLBD = pfLarge.bidirectionalDijkstra(sLarge, gLarge);
+    printResult("Large graph - Bidirectional Dijkstra", resLBD);
+
+    std::cout << "Running bidirectional A* (Euclidean) on large graph...\n";
+    auto resLBA = pfLarge.bidirectionalAstar(sLarge, gLarge, euclidLarge);
+    printResult("Large graph - Bidirectional A* (Euclidean)", resLBA);
+
+    // Contraction Hierarchies: preprocess once, save, reload and query
+    std::cout << "Contracting large graph...\n";
+    auto tc0 = std::chrono::high_resolution_clock::now();
+    ContractionHierarchy ch;
+    ch.build(large);
+    auto tc1 = std::chrono::high_resolution_clock::now();
+    std::cout << "CH built in " << std::chrono::duration<double>(tc1 - tc0).count() << " s, "
+              << ch.numShortcuts() << " shortcuts\n";
+
+    const std::string chFile = "large_graph.ch";
+    ContractionHierarchy loaded;
+    if (ch.save(chFile) && loaded.load(chFile)) {
+        std::cout << "Saved and reloaded " << chFile << "\n";
+    } else {
+        std::cout << "Could not write " << chFile << ", querying the in-memory hierarchy\n";
+        loaded = ch;
+    }
+    auto resLC = loaded.query(sLarge, gLarge);
+    printResult("Large graph - Contraction Hierarchies", resLC);
+
     return 0;
 }
@@ -2,20 +2,32 @@
 #include <cmath>
 #include <algorithm>
 #include <map>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 // --- DECISION TREE IMPLEMENTATION ---
 
+int attributeIndex(const std::string& name) {
+    if (name == "enemyNear") return ATTR_ENEMY_NEAR;
+    if (name == "isNearWall") return ATTR_IS_NEAR_WALL;
+    if (name == "canSeeEnemy") return ATTR_CAN_SEE_ENEMY;
+    if (name == "canHide") return ATTR_CAN_HIDE;
+    return -1;
+}
+
 void DTAction::print(int depth) {
     for(int i=0; i<depth; ++i) std::cout << "  ";
     std::cout << "-> ACTION: " << (int)action << "\n";
 }
 
+int DTAction::compile(FlatDecisionTree& out) const {
+    return out.addLeaf(action);
+}
+
 ActionType DTDecision::makeDecision(const WorldState& state) {
-    bool val = false;
-    if (attribute == "enemyNear") val = state.enemyNear;
-    else if (attribute == "isNearWall") val = state.isNearWall;
-    else if (attribute == "canSeeEnemy") val = state.canSeeEnemy;
-    else if (attribute == "canHide") val = state.canHide;
+    // Unknown attributes read as false
+    bool val = attrIndex >= 0 && ((state.pack() >> attrIndex) & 1u);
 
     if (val) return trueBranch->makeDecision(state);
     else return falseBranch->makeDecision(state);
@@ -26,4 +38,82 @@ void DTDecision::print(int depth) {
     std::cout << "?" << attribute << "\n";
     trueBranch->print(depth + 1);
     falseBranch->print(depth + 1);
-}
\ No newline at end of file
+}
+
+int DTDecision::compile(FlatDecisionTree& out) const {
+    // Unknown attribute: always false, so only that side is worth keeping
+    if (attrIndex < 0) return falseBranch->compile(out);
+
+    int self = out.addDecision(attrIndex);
+    int t = trueBranch->compile(out);
+    int f = falseBranch->compile(out);
+    out.setBranches(self, t, f);
+    return self;
+}
+
+// --- FLAT DECISION TREE ---
+
+FlatDecisionTree FlatDecisionTree::compile(const DTNode& root) {
+    FlatDecisionTree tree;
+    root.compile(tree);
+    return tree;
+}
+
+int FlatDecisionTree::addLeaf(ActionType action) {
+    nodes.push_back({-1, -1, -1, action});
+    return (int)nodes.size() - 1;
+}
+
+int FlatDecisionTree::addDecision(int attribute) {
+    nodes.push_back({attribute, -1, -1, ActionType::NONE});
+    return (int)nodes.size() - 1;
+}
+
+void FlatDecisionTree::setBranches(int node, int trueIdx, int falseIdx) {
+    nodes[node].trueIdx = trueIdx;
+    nodes[node].falseIdx = falseIdx;
+}
+
+int FlatDecisionTree::attributeBits() const {
+    int bits = 0;
+    for (const auto& n : nodes) bits = std::max(bits, n.attribute + 1);
+    return bits;
+}
+
+// --- DECISION TABLE ---
+
+DecisionTable DecisionTable::compile(const DTNode& root, int maxBits) {
+    return compile(FlatDecisionTree::compile(root), maxBits);
+}
+
+DecisionTable DecisionTable::compile(const FlatDecisionTree& tree, int maxBits) {
+    DecisionTable dt;
+    dt.tree = tree;
+    int bits = tree.attributeBits();
+    if (tree.empty() || bits > maxBits) return dt; // too wide to tabulate, stay a flat tree
+
+    // Bits above the highest tested attribute never change the answer
+    dt.mask = (std::uint32_t(1) << bits) - 1;
+    dt.table.resize((size_t)1 << bits);
+    for (std::uint32_t s = 0; s <= dt.mask; ++s) dt.table[s] = (std::int32_t)tree.decide(s);
+    return dt;
+}
+
+void DecisionTable::decideBatch(const std::uint32_t* packed, ActionType* out, int n) const {
+    if (table.empty()) {
+        for (int i = 0; i < n; ++i) out[i] = tree.decide(packed[i]);
+        return;
+    }
+
+    int i = 0;
+#if defined(__AVX2__)
+    static_assert(sizeof(ActionType) == sizeof(std::int32_t), "gathered entries are stored as ActionType");
+    const __m256i vmask = _mm256_set1_epi32((int)mask);
+    for (; i + 8 <= n; i += 8) {
+        __m256i idx = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(packed + i)), vmask);
+        __m256i act = _mm256_i32gather_epi32(table.data(), idx, 4);
+        _mm256_storeu_si256((__m256i*)(out + i), act);
+    }
+#endif
+    for (; i < n; ++i) out[i] = (ActionType)table[packed[i] & mask];
+}
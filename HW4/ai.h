@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <iostream>
+#include <cstdint>
 
 // --- SHARED DEFINITIONS ---
 
@@ -18,12 +19,32 @@ enum class ActionType {
     NONE
 };
 
+// Bit index of each WorldState attribute in WorldState::pack()
+enum DTAttribute : int {
+    ATTR_ENEMY_NEAR,
+    ATTR_IS_NEAR_WALL,
+    ATTR_CAN_SEE_ENEMY,
+    ATTR_CAN_HIDE,
+    ATTR_COUNT
+};
+
+// "enemyNear" -> ATTR_ENEMY_NEAR etc., -1 for a name WorldState doesn't have
+int attributeIndex(const std::string& name);
+
 // Represents the "Parameters" of the environment mentioned in HW4
 struct WorldState {
     bool enemyNear;      // Is enemy within threat range?
     bool isNearWall;
     bool canSeeEnemy;
     bool canHide;        // Is there a reachable hiding spot nearby?
+
+    // One bit per attribute, bit i = DTAttribute i
+    std::uint32_t pack() const {
+        return (std::uint32_t)enemyNear << ATTR_ENEMY_NEAR |
+               (std::uint32_t)isNearWall << ATTR_IS_NEAR_WALL |
+               (std::uint32_t)canSeeEnemy << ATTR_CAN_SEE_ENEMY |
+               (std::uint32_t)canHide << ATTR_CAN_HIDE;
+    }
     
     // Helper to print state for debugging
     std::string toString() const {
@@ -36,11 +57,15 @@ struct WorldState {
 
 // --- DECISION TREE CLASSES ---
 
+class FlatDecisionTree;
+
 class DTNode {
 public:
     virtual ~DTNode() = default;
     virtual ActionType makeDecision(const WorldState& state) = 0;
     virtual void print(int depth = 0) = 0;
+    // Appends this subtree to out in preorder, returns this node's index
+    virtual int compile(FlatDecisionTree& out) const = 0;
 };
 
 class DTAction : public DTNode {
@@ -50,17 +75,90 @@ public:
     // Fix: Comment out unused parameter name to silence warning
     ActionType makeDecision(const WorldState& /*state*/) override { return action; }
     void print(int depth = 0) override;
+    int compile(FlatDecisionTree& out) const override;
 };
 
 class DTDecision : public DTNode {
 public:
     std::string attribute; // "enemyNear", "energyLow", etc.
+    int attrIndex;         // attributeIndex(attribute), resolved once
     std::unique_ptr<DTNode> trueBranch;
     std::unique_ptr<DTNode> falseBranch;
 
     DTDecision(std::string attr, std::unique_ptr<DTNode> t, std::unique_ptr<DTNode> f)
-        : attribute(attr), trueBranch(std::move(t)), falseBranch(std::move(f)) {}
+        : attribute(attr), attrIndex(attributeIndex(attribute)), trueBranch(std::move(t)), falseBranch(std::move(f)) {}
 
     ActionType makeDecision(const WorldState& state) override;
     void print(int depth = 0) override;
+    int compile(FlatDecisionTree& out) const override;
+};
+
+// A DTNode tree lowered into one array, root at index 0, children always
+// after their parent. Evaluating it is a loop of shifts over a packed
+// WorldState: no virtual calls, no string compares, no pointer chasing
+// outside one small vector. Compile once per tree (it doesn't track changes
+// to the source tree).
+class FlatDecisionTree {
+public:
+    struct Node {
+        int attribute;     // DTAttribute, or -1 for a leaf
+        int trueIdx;
+        int falseIdx;
+        ActionType action; // leaves only
+    };
+
+    FlatDecisionTree() = default;
+    static FlatDecisionTree compile(const DTNode& root);
+
+    bool empty() const { return nodes.empty(); }
+    int size() const { return (int)nodes.size(); }
+    const std::vector<Node>& getNodes() const { return nodes; }
+
+    ActionType decide(std::uint32_t packed) const {
+        const Node* n = nodes.data();
+        while (n->attribute >= 0) n = nodes.data() + ((packed >> n->attribute) & 1u ? n->trueIdx : n->falseIdx);
+        return n->action;
+    }
+    ActionType decide(const WorldState& state) const { return decide(state.pack()); }
+
+    // Used by DTNode::compile
+    int addLeaf(ActionType action);
+    int addDecision(int attribute);
+    void setBranches(int node, int trueIdx, int falseIdx);
+
+    // Bits a packed state needs: highest attribute tested + 1
+    int attributeBits() const;
+
+private:
+    std::vector<Node> nodes;
+};
+
+// A tree tabulated over every packed state it can see: with k attributes
+// tested it is a function of k bits, so 2^k entries answer any state with one
+// load. Trees testing more than maxBits attributes keep the flat tree instead
+// (ATTR_COUNT is 4 today, so that is a 16 entry table). decideBatch() does
+// whole arrays of states, 8 at a time with AVX2 gathers when built with AVX2.
+class DecisionTable {
+public:
+    static constexpr int DEFAULT_MAX_BITS = 12; // 4K entries, 16 KB
+
+    DecisionTable() = default;
+    static DecisionTable compile(const DTNode& root, int maxBits = DEFAULT_MAX_BITS);
+    static DecisionTable compile(const FlatDecisionTree& tree, int maxBits = DEFAULT_MAX_BITS);
+
+    bool empty() const { return tree.empty(); }
+    bool isTabulated() const { return !table.empty(); }
+    const FlatDecisionTree& getTree() const { return tree; }
+
+    ActionType decide(std::uint32_t packed) const {
+        return table.empty() ? tree.decide(packed) : (ActionType)table[packed & mask];
+    }
+    ActionType decide(const WorldState& state) const { return decide(state.pack()); }
+    // out[i] = decide(packed[i]) for i < n
+    void decideBatch(const std::uint32_t* packed, ActionType* out, int n) const;
+
+private:
+    FlatDecisionTree tree;
+    std::vector<std::int32_t> table; // ActionType per packed state, int32 for the gathers
+    std::uint32_t mask = 0;
 };
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "bt.h"
 #include <algorithm>
-#include <random>
 #include <vector>
 
 BTStatus BTSelector::tick(EnemyContext& ctx) {
@@ -29,9 +28,7 @@ BTStatus BTRandomSelector::tick(EnemyContext& ctx) {
     std::vector<size_t> indices(children.size());
     for(size_t i = 0; i < children.size(); ++i) indices[i] = i;
 
-    static std::random_device rd;
-    static std::mt19937 g(rd());
-    std::shuffle(indices.begin(), indices.end(), g);
+    std::shuffle(indices.begin(), indices.end(), ctx.rng);
 
     for (size_t idx : indices) {
         BTStatus status = children[idx]->tick(ctx);
@@ -1,6 +1,7 @@
 #pragma once
 #include "steering.h" // For Kinematic
 #include "graph.h"    // For Graph
+#include "occupancy.h"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -9,10 +10,11 @@
 struct EnemyContext {
     Character& enemy;
     const Kinematic& player;
-    const std::vector<sf::FloatRect>& walls;
+    const OccupancyGrid& occupancy;
     const Graph& graph;
     float dt;
     float& danceTimer;
+    Rng& rng; // the enemy's own generator
 };
 
 enum class BTStatus {
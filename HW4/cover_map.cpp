@@ -0,0 +1,104 @@
+#include "cover_map.h"
+#include "steering.h" // WINDOW_WIDTH / WINDOW_HEIGHT
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void CoverMap::build(const OccupancyGrid& occ, float offset, float margin) {
+    occupancy = &occ;
+    points.clear();
+    for (const auto& wall : occ.getWalls()) {
+        const sf::Vector2f corners[4] = {
+            {wall.position.x - offset, wall.position.y - offset},
+            {wall.position.x + wall.size.x + offset, wall.position.y - offset},
+            {wall.position.x + wall.size.x + offset, wall.position.y + wall.size.y + offset},
+            {wall.position.x - offset, wall.position.y + wall.size.y + offset}
+        };
+        for (const auto& p : corners) {
+            if (p.x < margin || p.x > WINDOW_WIDTH - margin || p.y < margin || p.y > WINDOW_HEIGHT - margin) continue;
+            points.push_back(p);
+        }
+    }
+
+    // What each point sees, one bit per grid cell centre
+    int n = occ.numCells();
+    words = (n + 63) / 64;
+    sees.assign(points.size() * words, 0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        std::uint64_t* row = sees.data() + i * words;
+        for (int c = 0; c < n; ++c)
+            if (occ.raycast(points[i], occ.cellCenter(c))) row[c >> 6] |= std::uint64_t(1) << (c & 63);
+    }
+
+    // Buckets over the points' own bounding box, so every point lies inside
+    // its bucket and the ring search distance bound holds
+    bucketStart.clear();
+    bucketPoints.clear();
+    cols = rows = 0;
+    if (points.empty()) return;
+    cellSize = occ.getWallIndex().getCellSize();
+    sf::Vector2f lo = points[0], hi = points[0];
+    for (const auto& p : points) {
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+    }
+    origin = lo;
+    cols = (int)((hi.x - lo.x) / cellSize) + 1;
+    rows = (int)((hi.y - lo.y) / cellSize) + 1;
+
+    auto bucketOf = [&](sf::Vector2f p) {
+        int cx = std::min(cols - 1, (int)((p.x - origin.x) / cellSize));
+        int cy = std::min(rows - 1, (int)((p.y - origin.y) / cellSize));
+        return cy * cols + cx;
+    };
+    bucketStart.assign(cols * rows + 1, 0);
+    for (const auto& p : points) bucketStart[bucketOf(p) + 1]++;
+    for (int b = 0; b < cols * rows; ++b) bucketStart[b + 1] += bucketStart[b];
+    bucketPoints.resize(points.size());
+    std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < (int)points.size(); ++i) bucketPoints[fill[bucketOf(points[i])]++] = i;
+}
+
+sf::Vector2f CoverMap::nearestHidden(sf::Vector2f seeker, sf::Vector2f threat) const {
+    if (points.empty()) return {-1.f, -1.f};
+
+    int threatCell = occupancy->cellAt(threat); // -1: no bitset filter, raycasts only
+    int sx = std::clamp((int)std::floor((seeker.x - origin.x) / cellSize), 0, cols - 1);
+    int sy = std::clamp((int)std::floor((seeker.y - origin.y) / cellSize), 0, rows - 1);
+
+    int best = -1;
+    float bestD2 = std::numeric_limits<float>::infinity();
+    auto consider = [&](int bucket) {
+        for (int k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+            int i = bucketPoints[k];
+            if (threatCell >= 0 && seesCell(i, threatCell)) continue;
+            sf::Vector2f d = points[i] - seeker;
+            float d2 = d.x * d.x + d.y * d.y;
+            if (d2 > bestD2 || (d2 == bestD2 && i > best)) continue;
+            if (occupancy->raycast(points[i], threat)) continue; // centre was hidden, the threat itself is not
+            best = i;
+            bestD2 = d2;
+        }
+    };
+
+    int maxRing = std::max(cols, rows);
+    for (int r = 0; r <= maxRing; ++r) {
+        for (int y = sy - r; y <= sy + r; ++y) {
+            if (y < 0 || y >= rows) continue;
+            bool edgeRow = (y == sy - r || y == sy + r);
+            for (int x = sx - r; x <= sx + r; x += (edgeRow ? 1 : 2 * r)) {
+                if (x >= 0 && x < cols) consider(y * cols + x);
+                if (r == 0) break;
+            }
+        }
+        if (best < 0) continue;
+        // Anything in a later ring lies outside the box covered so far
+        float left = seeker.x - (origin.x + (sx - r) * cellSize);
+        float right = origin.x + (sx + r + 1) * cellSize - seeker.x;
+        float top = seeker.y - (origin.y + (sy - r) * cellSize);
+        float bottom = origin.y + (sy + r + 1) * cellSize - seeker.y;
+        float reach = std::min(std::min(left, right), std::min(top, bottom));
+        if (reach > 0.f && bestD2 < reach * reach) break;
+    }
+    return best >= 0 ? points[best] : sf::Vector2f(-1.f, -1.f);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "occupancy.h"
+#include <cstdint>
+#include <vector>
+
+// Precomputed hiding spots for a static map. The candidates are the points
+// findHidingSpot always used: each wall's corners pushed out diagonally by
+// offset, minus those within margin of the window edge. They are generated
+// once per map, and each gets a bitset over the occupancy grid's cells (bit c
+// set when the point sees the centre of cell c).
+//
+// nearestHidden() walks the candidate buckets in rings around the seeker,
+// nearest first. A candidate is tried only if its bit for the threat's cell
+// is clear, and only the best so far are confirmed with an exact raycast, so a
+// query costs a few bit tests and usually one or two raycasts.
+class CoverMap {
+public:
+    CoverMap() = default;
+    explicit CoverMap(const OccupancyGrid& occupancy, float offset = 40.f, float margin = 20.f) { build(occupancy, offset, margin); }
+
+    // Keeps a pointer to occupancy (exact checks); rebuild if it changes
+    void build(const OccupancyGrid& occupancy, float offset = 40.f, float margin = 20.f);
+
+    // Nearest candidate to seeker that threat cannot see, or (-1, -1).
+    // Candidates at equal distance resolve in wall order.
+    sf::Vector2f nearestHidden(sf::Vector2f seeker, sf::Vector2f threat) const;
+
+    int size() const { return (int)points.size(); }
+    const std::vector<sf::Vector2f>& getPoints() const { return points; }
+
+private:
+    const OccupancyGrid* occupancy = nullptr;
+    std::vector<sf::Vector2f> points; // in wall order
+    std::vector<std::uint64_t> sees;  // points.size() rows of words
+    int words = 0;
+
+    // Points bucketed by grid cell (counting sort)
+    std::vector<int> bucketStart;
+    std::vector<int> bucketPoints;
+    int cols = 0, rows = 0;
+    float cellSize = 1.f;
+    sf::Vector2f origin;
+
+    bool seesCell(int point, int cell) const { return (sees[(size_t)point * words + (cell >> 6)] >> (cell & 63)) & 1u; }
+};
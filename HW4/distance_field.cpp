@@ -0,0 +1,77 @@
+#include "distance_field.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+float rectSignedDistance(sf::Vector2f p, const sf::FloatRect& r) {
+    sf::Vector2f half = r.size * 0.5f;
+    sf::Vector2f c = r.position + half;
+    float qx = std::abs(p.x - c.x) - half.x;
+    float qy = std::abs(p.y - c.y) - half.y;
+    float outside = std::hypot(std::max(qx, 0.f), std::max(qy, 0.f));
+    float inside = std::min(std::max(qx, qy), 0.f);
+    return outside + inside;
+}
+
+void DistanceField::build(const std::vector<sf::FloatRect>& walls, sf::Vector2f o, float h, int c, int r) {
+    origin = o;
+    spacing = h;
+    cols = c;
+    rows = r;
+
+    // Exact per node; build time only, so a plain loop over the walls is fine
+    const float far = std::numeric_limits<float>::max();
+    dist.assign(cols * rows, far);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            sf::Vector2f p = origin + sf::Vector2f(x * h, y * h);
+            float d = far;
+            for (const auto& w : walls) d = std::min(d, rectSignedDistance(p, w));
+            dist[y * cols + x] = d;
+        }
+    }
+
+    // Central differences (one-sided on the border)
+    grad.assign(cols * rows, {0.f, 0.f});
+    if (walls.empty()) return;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            int x0 = std::max(x - 1, 0), x1 = std::min(x + 1, cols - 1);
+            int y0 = std::max(y - 1, 0), y1 = std::min(y + 1, rows - 1);
+            float gx = x1 > x0 ? (dist[y * cols + x1] - dist[y * cols + x0]) / ((x1 - x0) * h) : 0.f;
+            float gy = y1 > y0 ? (dist[y1 * cols + x] - dist[y0 * cols + x]) / ((y1 - y0) * h) : 0.f;
+            grad[y * cols + x] = {gx, gy};
+        }
+    }
+}
+
+void DistanceField::locate(sf::Vector2f p, int& x, int& y, float& fx, float& fy) const {
+    float gx = std::clamp((p.x - origin.x) / spacing, 0.f, (float)(cols - 1));
+    float gy = std::clamp((p.y - origin.y) / spacing, 0.f, (float)(rows - 1));
+    x = std::min((int)gx, cols - 2);
+    y = std::min((int)gy, rows - 2);
+    fx = gx - x;
+    fy = gy - y;
+}
+
+float DistanceField::sample(sf::Vector2f p) const {
+    int x, y;
+    float fx, fy;
+    locate(p, x, y, fx, fy);
+    const float* row0 = dist.data() + y * cols + x;
+    const float* row1 = row0 + cols;
+    float top = row0[0] + (row0[1] - row0[0]) * fx;
+    float bottom = row1[0] + (row1[1] - row1[0]) * fx;
+    return top + (bottom - top) * fy;
+}
+
+sf::Vector2f DistanceField::gradient(sf::Vector2f p) const {
+    int x, y;
+    float fx, fy;
+    locate(p, x, y, fx, fy);
+    const sf::Vector2f* row0 = grad.data() + y * cols + x;
+    const sf::Vector2f* row1 = row0 + cols;
+    sf::Vector2f top = row0[0] + (row0[1] - row0[0]) * fx;
+    sf::Vector2f bottom = row1[0] + (row1[1] - row1[0]) * fx;
+    return top + (bottom - top) * fy;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Signed distance to the nearest wall, sampled on a regular lattice of nodes
+// (spacing h, node (x, y) at origin + (x*h, y*h)) and read back with bilinear
+// interpolation. Negative inside a wall. The gradient is stored per node too
+// (central differences) and points away from the nearest wall, so proximity
+// tests, repulsion directions and collision push-out are one sample each.
+// Built once from the static walls; rebuild if they change.
+class DistanceField {
+public:
+    void build(const std::vector<sf::FloatRect>& walls, sf::Vector2f origin, float spacing, int cols, int rows);
+
+    bool empty() const { return dist.empty(); }
+    // Bilinear; points outside the lattice read the nearest border value
+    float sample(sf::Vector2f p) const;
+    // Unnormalized gradient (length ~1 away from medial lines), bilinear
+    sf::Vector2f gradient(sf::Vector2f p) const;
+
+    float getSpacing() const { return spacing; }
+
+private:
+    sf::Vector2f origin{0.f, 0.f};
+    float spacing = 1.f;
+    int cols = 0, rows = 0;
+    std::vector<float> dist;
+    std::vector<sf::Vector2f> grad;
+
+    // Lattice cell of p and the weights inside it
+    void locate(sf::Vector2f p, int& x, int& y, float& fx, float& fy) const;
+};
+
+// Exact signed distance from p to one rectangle (negative inside)
+float rectSignedDistance(sf::Vector2f p, const sf::FloatRect& r);
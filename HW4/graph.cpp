@@ -1,18 +1,53 @@
 #include "graph.h"
 #include "steering.h" // Needed for WINDOW_WIDTH / WINDOW_HEIGHT
+#include <atomic>
 #include <cmath>
 #include <iostream>
 
-Graph::Graph(int n, bool spatial) : numVertices(n), adj(n), cols(0), rows(0) {
+Graph::Graph(int n, bool spatial) : numVertices(n), adj(n), cols(0), rows(0), cellSize(0.f) {
     if (spatial) positions.resize(n);
+    markChanged();
+}
+
+void Graph::markChanged() {
+    static std::atomic<unsigned> nextRevision{1};
+    revision = nextRevision++;
+}
+
+void CSRGraph::build(const std::vector<std::vector<Edge>>& adj) {
+    offsets.assign(adj.size() + 1, 0);
+    for (size_t u = 0; u < adj.size(); ++u) offsets[u + 1] = offsets[u] + (int)adj[u].size();
+
+    to.resize(offsets.back());
+    weight.resize(offsets.back());
+    for (size_t u = 0; u < adj.size(); ++u) {
+        int i = offsets[u];
+        for (const Edge& e : adj[u]) {
+            to[i] = e.to;
+            weight[i] = e.weight;
+            ++i;
+        }
+    }
+}
+
+void CSRGraph::clear() {
+    offsets.clear();
+    to.clear();
+    weight.clear();
 }
 
 void Graph::addEdge(int u, int v, float w) {
     if (u >= 0 && u < numVertices && v >= 0 && v < numVertices) {
         adj[u].emplace_back(v, w);
+        if (isFinalized()) csr.clear(); // stale now, fall back to adj until re-finalized
+        markChanged();
     }
 }
 
+void Graph::finalize() {
+    csr.build(adj);
+}
+
 int Graph::getNodeAt(float x, float y, float cellSize) const { // Added const
     int gx = static_cast<int>(x / cellSize);
     int gy = static_cast<int>(y / cellSize);
@@ -99,6 +134,7 @@ Graph createFourRoomGraph(std::vector<sf::FloatRect>& walls) {
     Graph g(0, true);
     g.cols = COLS;
     g.rows = ROWS;
+    g.cellSize = CELL_SIZE;
     g.gridMap.resize(COLS * ROWS, -1);
 
     int nodeCounter = 0;
@@ -157,5 +193,10 @@ Graph createFourRoomGraph(std::vector<sf::FloatRect>& walls) {
             }
         }
     }
+    g.finalize();
+
+    // 5px lattice over the window, nodes on both borders
+    const float FIELD_STEP = 5.f;
+    g.distanceField.build(walls, {0.f, 0.f}, FIELD_STEP, WINDOW_WIDTH / (int)FIELD_STEP + 1, WINDOW_HEIGHT / (int)FIELD_STEP + 1);
     return g;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <SFML/Graphics.hpp>
+#include "distance_field.h"
 
 struct Edge {
     int to;
@@ -8,19 +9,62 @@ struct Edge {
     Edge(int t, float w) : to(t), weight(w) {}
 };
 
+// Frozen compressed-sparse-row adjacency: the edges of u live in
+// [offsets[u], offsets[u+1]) of the contiguous to[] / weight[] arrays.
+struct CSRGraph {
+    std::vector<int> offsets;
+    std::vector<int> to;
+    std::vector<float> weight;
+
+    void build(const std::vector<std::vector<Edge>>& adj);
+    void clear();
+    bool empty() const { return offsets.empty(); }
+};
+
+// Neighbour iteration that works on either adjacency layout, so searches can be
+// templated over it: fn(to, weight) is called for every out-edge of u.
+template <class Fn>
+inline void forEachEdge(const std::vector<std::vector<Edge>>& adj, int u, Fn&& fn) {
+    for (const Edge& e : adj[u]) fn(e.to, e.weight);
+}
+
+template <class Fn>
+inline void forEachEdge(const CSRGraph& csr, int u, Fn&& fn) {
+    for (int i = csr.offsets[u], end = csr.offsets[u + 1]; i < end; ++i) fn(csr.to[i], csr.weight[i]);
+}
+
 struct Graph {
     int numVertices;
     std::vector<std::vector<Edge>> adj;
+    CSRGraph csr; // filled by finalize(); searches prefer it when present
     std::vector<sf::Vector2f> positions;
 
     // Helper to map grid coordinates to node ID (-1 if invalid/wall)
     std::vector<int> gridMap; 
     int cols, rows;
+    float cellSize; // side of one grid cell in pixels (0 for non-grid graphs)
+    // Bumped whenever the layout changes (addEdge, or markChanged() after editing
+    // gridMap / walls). Unique across Graph instances, so caches keyed on it
+    // also notice when the whole graph is rebuilt.
+    unsigned revision;
+    // Signed distance to the walls (createFourRoomGraph fills it; rebuild it
+    // along with markChanged() if the walls move)
+    DistanceField distanceField;
 
     Graph(int n = 0, bool spatial = false);
-    void addEdge(int u, int v, float w);
+    void addEdge(int u, int v, float w); // un-freezes the graph if finalized
+    void finalize();                      // builds csr from adj once construction is done
+    void markChanged();                   // invalidates everything cached against this graph
+    bool isFinalized() const { return !csr.empty(); }
     int getNodeAt(float x, float y, float cellSize) const; // Added const
 };
 
+// Out-edges of u from csr when the graph is finalized, from adj otherwise
+template <class Fn>
+inline void forEachEdge(const Graph& g, int u, Fn&& fn) {
+    if (g.isFinalized()) forEachEdge(g.csr, u, fn);
+    else forEachEdge(g.adj, u, fn);
+}
+
 // Returns the graph and fills the obstacles vector for rendering
 Graph createFourRoomGraph(std::vector<sf::FloatRect>& walls);
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include "hpa.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const float INF = std::numeric_limits<float>::infinity();
+const float DIAG = 1.414f; // must match the diagonal cost used by createFourRoomGraph
+const int SPLIT_RUN = 6;   // runs at least this long get an entrance at each end
+
+float octile(int x0, int y0, int x1, int y1, float cell) {
+    int dx = std::abs(x1 - x0), dy = std::abs(y1 - y0);
+    int diag = std::min(dx, dy);
+    return cell * (float)(dx + dy - 2 * diag) + cell * DIAG * (float)diag;
+}
+
+double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+} // namespace
+
+HPAGraph::HPAGraph(int clusterSize) : clusterSize(std::max(2, clusterSize)) {}
+
+int HPAGraph::clusterOfCell(int cell) const {
+    int x = cell % cols, y = cell / cols;
+    return (y / clusterSize) * ccols + (x / clusterSize);
+}
+
+int HPAGraph::cellOfNode(const Graph& g, int node) const {
+    int x = static_cast<int>(g.positions[node].x / cellSize);
+    int y = static_cast<int>(g.positions[node].y / cellSize);
+    return y * cols + x;
+}
+
+// --- Construction ---
+
+void HPAGraph::build(const Graph& g) {
+    cols = g.cols;
+    rows = g.rows;
+    cellSize = g.cellSize;
+    clusters.clear();
+    borders.clear();
+    abstractCell.clear();
+    cellToAbstract.clear();
+    abstractAdj.clear();
+    if (cols <= 0 || rows <= 0 || cellSize <= 0.f) return; // not a grid graph
+
+    ccols = (cols + clusterSize - 1) / clusterSize;
+    crows = (rows + clusterSize - 1) / clusterSize;
+
+    clusters.resize(ccols * crows);
+    for (int cy = 0; cy < crows; ++cy) {
+        for (int cx = 0; cx < ccols; ++cx) {
+            Cluster& c = clusters[cy * ccols + cx];
+            c.x0 = cx * clusterSize;
+            c.y0 = cy * clusterSize;
+            c.x1 = std::min(cols, c.x0 + clusterSize);
+            c.y1 = std::min(rows, c.y0 + clusterSize);
+        }
+    }
+
+    borders.assign(crows * (ccols - 1) + (crows - 1) * ccols, {});
+    for (int cy = 0; cy < crows; ++cy) {
+        for (int cx = 0; cx < ccols; ++cx) {
+            if (cx + 1 < ccols) buildVerticalBorder(g, cx, cy);
+            if (cy + 1 < crows) buildHorizontalBorder(g, cx, cy);
+        }
+    }
+    for (int c = 0; c < (int)clusters.size(); ++c) buildCluster(g, c);
+    assemble();
+}
+
+void HPAGraph::rebuildArea(const Graph& g, const sf::FloatRect& area) {
+    if (clusters.empty() || g.cols != cols || g.rows != rows || g.cellSize != cellSize) {
+        build(g);
+        return;
+    }
+
+    // Cells are blocked by anything within half a cell, so pad by one cell
+    int x0 = std::max(0, (int)std::floor(area.position.x / cellSize) - 1);
+    int y0 = std::max(0, (int)std::floor(area.position.y / cellSize) - 1);
+    int x1 = std::min(cols - 1, (int)std::floor((area.position.x + area.size.x) / cellSize) + 1);
+    int y1 = std::min(rows - 1, (int)std::floor((area.position.y + area.size.y) / cellSize) + 1);
+    if (x0 > x1 || y0 > y1) return;
+
+    int cx0 = x0 / clusterSize, cx1 = x1 / clusterSize;
+    int cy0 = y0 / clusterSize, cy1 = y1 / clusterSize;
+
+    // Every border of a dirty cluster may have new transitions...
+    for (int cy = cy0; cy <= cy1; ++cy)
+        for (int cx = std::max(0, cx0 - 1); cx <= cx1 && cx + 1 < ccols; ++cx)
+            buildVerticalBorder(g, cx, cy);
+    for (int cy = std::max(0, cy0 - 1); cy <= cy1 && cy + 1 < crows; ++cy)
+        for (int cx = cx0; cx <= cx1; ++cx)
+            buildHorizontalBorder(g, cx, cy);
+
+    // ...so the clusters on the other side of those borders need new costs too
+    for (int cy = std::max(0, cy0 - 1); cy <= std::min(crows - 1, cy1 + 1); ++cy)
+        for (int cx = std::max(0, cx0 - 1); cx <= std::min(ccols - 1, cx1 + 1); ++cx)
+            buildCluster(g, cy * ccols + cx);
+    assemble();
+}
+
+// Scans the shared column between cluster (cx,cy) and (cx+1,cy) for open runs
+void HPAGraph::buildVerticalBorder(const Graph& g, int cx, int cy) {
+    std::vector<Transition>& out = borders[verticalBorder(cx, cy)];
+    out.clear();
+    const int xl = (cx + 1) * clusterSize - 1, xr = xl + 1;
+    const int ya = cy * clusterSize, yb = std::min(rows, ya + clusterSize);
+
+    auto open = [&](int y) { return g.gridMap[y * cols + xl] != -1 && g.gridMap[y * cols + xr] != -1; };
+    auto add = [&](int y) { out.push_back({y * cols + xl, y * cols + xr}); };
+
+    for (int y = ya; y < yb;) {
+        if (!open(y)) { ++y; continue; }
+        int s = y;
+        while (y < yb && open(y)) ++y;
+        if (y - s < SPLIT_RUN) add(s + (y - s) / 2);
+        else { add(s); add(y - 1); }
+    }
+}
+
+// Same for the shared row between cluster (cx,cy) and (cx,cy+1)
+void HPAGraph::buildHorizontalBorder(const Graph& g, int cx, int cy) {
+    std::vector<Transition>& out = borders[horizontalBorder(cx, cy)];
+    out.clear();
+    const int yt = (cy + 1) * clusterSize - 1, yb = yt + 1;
+    const int xa = cx * clusterSize, xb = std::min(cols, xa + clusterSize);
+
+    auto open = [&](int x) { return g.gridMap[yt * cols + x] != -1 && g.gridMap[yb * cols + x] != -1; };
+    auto add = [&](int x) { out.push_back({yt * cols + x, yb * cols + x}); };
+
+    for (int x = xa; x < xb;) {
+        if (!open(x)) { ++x; continue; }
+        int s = x;
+        while (x < xb && open(x)) ++x;
+        if (x - s < SPLIT_RUN) add(s + (x - s) / 2);
+        else { add(s); add(x - 1); }
+    }
+}
+
+// Collects the cluster's entrance cells and their pairwise intra-cluster costs
+void HPAGraph::buildCluster(const Graph& g, int c) {
+    Cluster& cl = clusters[c];
+    const int cx = c % ccols, cy = c / ccols;
+
+    cl.entrances.clear();
+    auto take = [&](int border, bool sideA) {
+        for (const Transition& t : borders[border]) cl.entrances.push_back(sideA ? t.cellA : t.cellB);
+    };
+    if (cx > 0) take(verticalBorder(cx - 1, cy), false);
+    if (cx + 1 < ccols) take(verticalBorder(cx, cy), true);
+    if (cy > 0) take(horizontalBorder(cx, cy - 1), false);
+    if (cy + 1 < crows) take(horizontalBorder(cx, cy), true);
+
+    // A corner cell can be an entrance on two borders
+    std::sort(cl.entrances.begin(), cl.entrances.end());
+    cl.entrances.erase(std::unique(cl.entrances.begin(), cl.entrances.end()), cl.entrances.end());
+
+    const int k = (int)cl.entrances.size();
+    cl.dist.assign(k * k, INF);
+    Metrics unused;
+    for (int i = 0; i < k; ++i) {
+        clusterSearch(g, g.gridMap[cl.entrances[i]], -1, cl, unused);
+        for (int j = 0; j < k; ++j) cl.dist[i * k + j] = gridCtx.g(g.gridMap[cl.entrances[j]]);
+    }
+}
+
+// Flattens the per-cluster entrances / costs and the transitions into abstractAdj
+void HPAGraph::assemble() {
+    abstractCell.clear();
+    cellToAbstract.assign(cols * rows, -1);
+    for (const Cluster& cl : clusters) {
+        for (int cell : cl.entrances) {
+            cellToAbstract[cell] = (int)abstractCell.size();
+            abstractCell.push_back(cell);
+        }
+    }
+
+    abstractAdj.assign(abstractCell.size(), {});
+    for (const Cluster& cl : clusters) {
+        const int k = (int)cl.entrances.size();
+        for (int i = 0; i < k; ++i) {
+            int a = cellToAbstract[cl.entrances[i]];
+            for (int j = 0; j < k; ++j) {
+                if (i != j && cl.dist[i * k + j] < INF)
+                    abstractAdj[a].emplace_back(cellToAbstract[cl.entrances[j]], cl.dist[i * k + j]);
+            }
+        }
+    }
+    for (const auto& border : borders) {
+        for (const Transition& t : border) {
+            int a = cellToAbstract[t.cellA], b = cellToAbstract[t.cellB];
+            abstractAdj[a].emplace_back(b, cellSize);
+            abstractAdj[b].emplace_back(a, cellSize);
+        }
+    }
+}
+
+// --- Queries ---
+
+void HPAGraph::clusterSearch(const Graph& g, int source, int goal, const Cluster& c, Metrics& m) {
+    gridCtx.begin(g.numVertices);
+    int gx = 0, gy = 0;
+    if (goal != -1) {
+        int gc = cellOfNode(g, goal);
+        gx = gc % cols;
+        gy = gc / cols;
+    }
+    auto h = [&](int v) {
+        if (goal == -1) return 0.f;
+        int cell = cellOfNode(g, v);
+        return octile(cell % cols, cell / cols, gx, gy, cellSize);
+    };
+
+    gridCtx.relax(source, 0.f, -1);
+    gridCtx.open.push(source, h(source));
+    while (!gridCtx.open.empty()) {
+        m.max_fringe = std::max(m.max_fringe, gridCtx.open.size());
+        int u = gridCtx.open.pop();
+        gridCtx.close(u);
+        m.fill++;
+        if (u == goal) break;
+
+        float gu = gridCtx.g(u);
+        forEachEdge(g, u, [&](int v, float w) {
+            if (gridCtx.closed(v)) return;
+            int cell = cellOfNode(g, v);
+            int x = cell % cols, y = cell / cols;
+            if (x < c.x0 || x >= c.x1 || y < c.y0 || y >= c.y1) return;
+            float ng = gu + w;
+            if (ng < gridCtx.g(v)) {
+                gridCtx.relax(v, ng, u);
+                gridCtx.open.push(v, ng + h(v));
+            }
+        });
+    }
+}
+
+std::vector<int> HPAGraph::findAbstractPath(const Graph& g, int start, int goal, HPAMetrics& m) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    m = HPAMetrics{};
+    if (clusters.empty() || start < 0 || goal < 0) return {};
+    if (start == goal) return {start};
+
+    const int sc = cellOfNode(g, start), gc = cellOfNode(g, goal);
+    const Cluster& cs = clusters[clusterOfCell(sc)];
+    const Cluster& cg = clusters[clusterOfCell(gc)];
+
+    // Temporary edges: S = start, G = goal appended after the real abstract nodes
+    const int N = (int)abstractCell.size();
+    const int S = N, G = N + 1;
+    std::vector<std::pair<int, float>> startLinks, goalLinks;
+
+    clusterSearch(g, start, -1, cs, m.insert);
+    for (int cell : cs.entrances) {
+        float d = gridCtx.g(g.gridMap[cell]);
+        if (d < INF) startLinks.emplace_back(cellToAbstract[cell], d);
+    }
+    if (&cs == &cg && gridCtx.g(goal) < INF) startLinks.emplace_back(G, gridCtx.g(goal));
+
+    clusterSearch(g, goal, -1, cg, m.insert);
+    for (int cell : cg.entrances) {
+        float d = gridCtx.g(g.gridMap[cell]);
+        if (d < INF) goalLinks.emplace_back(cellToAbstract[cell], d);
+    }
+
+    // A* over the abstract graph with the octile distance between cells
+    auto cellOf = [&](int a) { return a == S ? sc : a == G ? gc : abstractCell[a]; };
+    auto h = [&](int a) {
+        int cell = cellOf(a);
+        return octile(cell % cols, cell / cols, gc % cols, gc / cols, cellSize);
+    };
+
+    abstractCtx.begin(N + 2);
+    abstractCtx.relax(S, 0.f, -1);
+    abstractCtx.open.push(S, h(S));
+    while (!abstractCtx.open.empty()) {
+        m.abstract.max_fringe = std::max(m.abstract.max_fringe, abstractCtx.open.size());
+        int u = abstractCtx.open.pop();
+        abstractCtx.close(u);
+        m.abstract.fill++;
+        if (u == G) break;
+
+        float gu = abstractCtx.g(u);
+        auto relax = [&](int v, float w) {
+            if (abstractCtx.closed(v)) return;
+            float ng = gu + w;
+            if (ng < abstractCtx.g(v)) {
+                abstractCtx.relax(v, ng, u);
+                abstractCtx.open.push(v, ng + h(v));
+            }
+        };
+        if (u == S) {
+            for (const auto& l : startLinks) relax(l.first, l.second);
+            continue;
+        }
+        for (const auto& e : abstractAdj[u]) relax(e.first, e.second);
+        for (const auto& l : goalLinks) {
+            if (l.first == u) relax(G, l.second);
+        }
+    }
+
+    std::vector<int> path;
+    if (abstractCtx.closed(G)) {
+        for (int a = G; a != -1; a = abstractCtx.parent(a)) {
+            path.push_back(a == S ? start : a == G ? goal : g.gridMap[abstractCell[a]]);
+        }
+        std::reverse(path.begin(), path.end());
+    }
+
+    m.fill = m.insert.fill + m.abstract.fill;
+    m.max_fringe = std::max(m.insert.max_fringe, m.abstract.max_fringe);
+    m.runtime_ms = msSince(t0);
+    return path;
+}
+
+std::vector<int> HPAGraph::refineSegment(const Graph& g, int from, int to, Metrics& m) {
+    if (from == to) return {from};
+    int cf = clusterOfCell(cellOfNode(g, from));
+    int ct = clusterOfCell(cellOfNode(g, to));
+    if (cf != ct) return {from, to}; // the two sides of a transition are neighbours
+
+    clusterSearch(g, from, to, clusters[cf], m);
+    if (!gridCtx.closed(to)) return {};
+    std::vector<int> path;
+    for (int v = to; v != -1; v = gridCtx.parent(v)) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<int> HPAGraph::findPath(const Graph& g, int start, int goal, HPAMetrics& m) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<int> waypoints = findAbstractPath(g, start, goal, m);
+
+    std::vector<int> path;
+    if (!waypoints.empty()) path.push_back(waypoints.front());
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        std::vector<int> seg = refineSegment(g, waypoints[i - 1], waypoints[i], m.refine);
+        if (seg.empty()) return {};
+        path.insert(path.end(), seg.begin() + 1, seg.end());
+    }
+
+    m.fill += m.refine.fill;
+    m.max_fringe = std::max(m.max_fringe, m.refine.max_fringe);
+    m.runtime_ms = msSince(t0);
+    return path;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "graph.h"
+#include "pathfinding.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <utility>
+
+// Totals match Metrics so HPA* can be benchmarked against flat aStar / jpsGrid.
+// The breakdown shows where the work went.
+struct HPAMetrics : Metrics {
+    Metrics insert;   // connecting start / goal to their cluster's entrances
+    Metrics abstract; // A* over the abstract graph
+    Metrics refine;   // all refineSegment calls made by findPath
+};
+
+// HPA* over the uniform grid built by createFourRoomGraph.
+// The grid is cut into square clusters; every open run along a cluster border
+// gets one or two entrance pairs, and entrances of the same cluster are linked
+// with their exact intra-cluster cost. Everything is stored by cell index, not
+// node id, so a rebuilt Graph can be re-synced with rebuildArea() and only the
+// clusters touching the changed walls are recomputed.
+class HPAGraph {
+public:
+    explicit HPAGraph(int clusterSize = 10);
+
+    void build(const Graph& g);
+    // Call after regenerating the graph when walls inside area changed
+    void rebuildArea(const Graph& g, const sf::FloatRect& area);
+
+    // Node ids start, entrances..., goal. Consecutive waypoints are either in the
+    // same cluster or are the two sides of a transition. Empty if unreachable.
+    std::vector<int> findAbstractPath(const Graph& g, int start, int goal, HPAMetrics& m);
+    // Grid path between two consecutive waypoints (lazy refinement)
+    std::vector<int> refineSegment(const Graph& g, int from, int to, Metrics& m);
+    // Abstract search + refinement of every segment, full node-id path like aStar
+    std::vector<int> findPath(const Graph& g, int start, int goal, HPAMetrics& m);
+
+    int numClusters() const { return (int)clusters.size(); }
+    int numAbstractNodes() const { return (int)abstractCell.size(); }
+
+private:
+    struct Transition {
+        int cellA, cellB; // cellA in the left / top cluster, cellB in the right / bottom one
+    };
+    struct Cluster {
+        int x0, y0, x1, y1;         // cell bounds, [x0,x1) x [y0,y1)
+        std::vector<int> entrances; // cells
+        std::vector<float> dist;    // entrances^2 intra-cluster costs (inf if unreachable)
+    };
+
+    int clusterSize;
+    int cols = 0, rows = 0, ccols = 0, crows = 0;
+    float cellSize = 0.f;
+
+    std::vector<Cluster> clusters;
+    std::vector<std::vector<Transition>> borders; // vertical borders first, then horizontal
+
+    // Abstract graph assembled from the per-cluster data
+    std::vector<int> abstractCell;
+    std::vector<int> cellToAbstract;
+    std::vector<std::vector<std::pair<int, float>>> abstractAdj;
+
+    SearchContext gridCtx;
+    SearchContext abstractCtx;
+
+    int clusterOfCell(int cell) const;
+    int cellOfNode(const Graph& g, int node) const;
+    int verticalBorder(int cx, int cy) const { return cy * (ccols - 1) + cx; }              // cx | cx+1
+    int horizontalBorder(int cx, int cy) const { return crows * (ccols - 1) + cy * ccols + cx; } // cy / cy+1
+
+    void buildVerticalBorder(const Graph& g, int cx, int cy);
+    void buildHorizontalBorder(const Graph& g, int cx, int cy);
+    void buildCluster(const Graph& g, int c);
+    void assemble();
+
+    // A* from source that never leaves cluster c (plain Dijkstra sweep if goal is -1)
+    void clusterSearch(const Graph& g, int source, int goal, const Cluster& c, Metrics& m);
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <vector>
+
+// Indexed 4-ary min-heap over vertex ids [0, n).
+// Each vertex is queued at most once; pos[] tracks its slot so push() on a
+// vertex that is already queued is a true decrease-key instead of a duplicate.
+class IndexedHeap {
+public:
+    explicit IndexedHeap(int n = 0) { reset(n); }
+
+    // Resizes the position table and empties the heap (O(n))
+    void reset(int n) {
+        heap.clear();
+        pos.assign(n, -1);
+    }
+
+    // Empties the heap, only touching the vertices still queued (O(size))
+    void clear() {
+        for (const Entry& e : heap) pos[e.v] = -1;
+        heap.clear();
+    }
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return (int)heap.size(); }
+    int capacity() const { return (int)pos.size(); }
+    bool contains(int v) const { return pos[v] != -1; }
+    float topKey() const { return heap.front().key; }
+    int top() const { return heap.front().v; }
+
+    // Inserts v, or lowers its key if it is already queued with a larger one
+    void push(int v, float key) {
+        int i = pos[v];
+        if (i == -1) {
+            i = (int)heap.size();
+            heap.push_back({key, v});
+            pos[v] = i;
+        } else if (key < heap[i].key) {
+            heap[i].key = key;
+        } else {
+            return;
+        }
+        siftUp(i);
+    }
+
+    // Removes and returns the vertex with the smallest key
+    int pop() {
+        int v = heap.front().v;
+        pos[v] = -1;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last.v] = 0;
+            siftDown(0);
+        }
+        return v;
+    }
+
+private:
+    static constexpr int D = 4;
+
+    struct Entry {
+        float key;
+        int v;
+    };
+
+    std::vector<Entry> heap;
+    std::vector<int> pos; // slot in heap, -1 if not queued
+
+    void siftUp(int i) {
+        Entry e = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!(e.key < heap[parent].key)) break;
+            heap[i] = heap[parent];
+            pos[heap[i].v] = i;
+            i = parent;
+        }
+        heap[i] = e;
+        pos[e.v] = i;
+    }
+
+    void siftDown(int i) {
+        Entry e = heap[i];
+        const int n = (int)heap.size();
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n) break;
+            int best = first;
+            int last = first + D < n ? first + D : n;
+            for (int c = first + 1; c < last; ++c) {
+                if (heap[c].key < heap[best].key) best = c;
+            }
+            if (!(heap[best].key < e.key)) break;
+            heap[i] = heap[best];
+            pos[heap[i].v] = i;
+            i = best;
+        }
+        heap[i] = e;
+        pos[e.v] = i;
+    }
+};
@@ -0,0 +1,176 @@
+#include "jps.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+const float DIAG = 1.414f; // must match the diagonal cost used by createFourRoomGraph
+
+struct Grid {
+    const Graph& g;
+
+    bool open(int x, int y) const {
+        return x >= 0 && x < g.cols && y >= 0 && y < g.rows && g.gridMap[y * g.cols + x] != -1;
+    }
+    int node(int x, int y) const { return g.gridMap[y * g.cols + x]; }
+    int cellX(int node) const { return static_cast<int>(g.positions[node].x / g.cellSize); }
+    int cellY(int node) const { return static_cast<int>(g.positions[node].y / g.cellSize); }
+};
+
+int sign(int v) { return (v > 0) - (v < 0); }
+
+// Octile distance, consistent with the grid's straight / diagonal costs
+float octile(int x0, int y0, int x1, int y1, float cell) {
+    int dx = std::abs(x1 - x0), dy = std::abs(y1 - y0);
+    int diag = std::min(dx, dy);
+    return cell * (float)(dx + dy - 2 * diag) + cell * DIAG * (float)diag;
+}
+
+// Can we take one step from (x,y) in direction (dx,dy)? Diagonals need both
+// orthogonal cells open (no corner cutting).
+bool canStep(const Grid& grid, int x, int y, int dx, int dy) {
+    if (!grid.open(x + dx, y + dy)) return false;
+    if (dx != 0 && dy != 0) return grid.open(x + dx, y) && grid.open(x, y + dy);
+    return true;
+}
+
+// Moves from (x,y) in direction (dx,dy) until it hits a jump point (goal, a cell
+// with a forced neighbour, or for diagonals a cell whose straight jumps succeed).
+bool jump(const Grid& grid, int x, int y, int dx, int dy, int gx, int gy, int& jx, int& jy) {
+    while (canStep(grid, x, y, dx, dy)) {
+        x += dx;
+        y += dy;
+
+        bool found = (x == gx && y == gy);
+        if (!found && dx != 0 && dy != 0) {
+            int tx, ty;
+            found = jump(grid, x, y, dx, 0, gx, gy, tx, ty) || jump(grid, x, y, 0, dy, gx, gy, tx, ty);
+        } else if (!found && dx != 0) {
+            found = (grid.open(x, y - 1) && !grid.open(x - dx, y - 1)) ||
+                    (grid.open(x, y + 1) && !grid.open(x - dx, y + 1));
+        } else if (!found) {
+            found = (grid.open(x - 1, y) && !grid.open(x - 1, y - dy)) ||
+                    (grid.open(x + 1, y) && !grid.open(x + 1, y - dy));
+        }
+
+        if (found) {
+            jx = x;
+            jy = y;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Directions worth searching from (x,y) given the direction we arrived from
+int prunedDirections(const Grid& grid, int x, int y, int dx, int dy, int out[8][2]) {
+    int n = 0;
+    auto add = [&](int ax, int ay) { out[n][0] = ax; out[n][1] = ay; ++n; };
+
+    if (dx == 0 && dy == 0) { // start node: everything
+        for (int ax = -1; ax <= 1; ++ax)
+            for (int ay = -1; ay <= 1; ++ay)
+                if ((ax || ay) && canStep(grid, x, y, ax, ay)) add(ax, ay);
+        return n;
+    }
+
+    if (dx != 0 && dy != 0) {
+        if (grid.open(x, y + dy)) add(0, dy);
+        if (grid.open(x + dx, y)) add(dx, 0);
+        if (grid.open(x, y + dy) && grid.open(x + dx, y)) add(dx, dy);
+    } else if (dx != 0) {
+        bool next = grid.open(x + dx, y), up = grid.open(x, y - 1), down = grid.open(x, y + 1);
+        if (next) {
+            add(dx, 0);
+            if (up) add(dx, -1);
+            if (down) add(dx, 1);
+        }
+        if (up) add(0, -1);
+        if (down) add(0, 1);
+    } else {
+        bool next = grid.open(x, y + dy), left = grid.open(x - 1, y), right = grid.open(x + 1, y);
+        if (next) {
+            add(0, dy);
+            if (left) add(-1, dy);
+            if (right) add(1, dy);
+        }
+        if (left) add(-1, 0);
+        if (right) add(1, 0);
+    }
+    return n;
+}
+
+} // namespace
+
+std::vector<int> jpsGrid(const Graph& g, int start, int goal, Metrics& m) {
+    return jpsGrid(g, start, goal, m, threadSearchContext());
+}
+
+std::vector<int> jpsGrid(const Graph& g, int start, int goal, Metrics& m, SearchContext& ctx) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const Grid grid{g};
+    const float cell = g.cellSize;
+    const int gx = grid.cellX(goal), gy = grid.cellY(goal);
+
+    ctx.begin(g.numVertices);
+    ctx.relax(start, 0.f, -1);
+    ctx.open.push(start, octile(grid.cellX(start), grid.cellY(start), gx, gy, cell));
+    m.max_fringe = 1;
+    m.fill = 0;
+
+    while (!ctx.open.empty()) {
+        int u = ctx.open.pop();
+        ctx.close(u);
+        m.fill++;
+        if (u == goal) break;
+
+        int x = grid.cellX(u), y = grid.cellY(u);
+        int px = x, py = y;
+        if (ctx.parent(u) != -1) {
+            px = grid.cellX(ctx.parent(u));
+            py = grid.cellY(ctx.parent(u));
+        }
+
+        int dirs[8][2];
+        int count = prunedDirections(grid, x, y, sign(x - px), sign(y - py), dirs);
+        for (int i = 0; i < count; ++i) {
+            int jx, jy;
+            if (!jump(grid, x, y, dirs[i][0], dirs[i][1], gx, gy, jx, jy)) continue;
+
+            int v = grid.node(jx, jy);
+            if (ctx.closed(v)) continue;
+            int steps = std::max(std::abs(jx - x), std::abs(jy - y));
+            float stepCost = (dirs[i][0] != 0 && dirs[i][1] != 0) ? cell * DIAG : cell;
+            float tent_g = ctx.g(u) + stepCost * (float)steps;
+            if (tent_g < ctx.g(v)) {
+                ctx.relax(v, tent_g, u);
+                ctx.open.push(v, tent_g + octile(jx, jy, gx, gy, cell));
+            }
+        }
+        m.max_fringe = std::max(m.max_fringe, ctx.open.size());
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    m.runtime_ms = std::chrono::duration<float, std::milli>(t1 - t0).count();
+
+    std::vector<int> path;
+    if (!ctx.closed(goal)) return path;
+
+    // Expand jump point segments (each is purely straight or diagonal) into cells
+    std::vector<int> jumps;
+    for (int at = goal; at != -1; at = ctx.parent(at)) jumps.push_back(at);
+    std::reverse(jumps.begin(), jumps.end());
+    path.push_back(jumps.front());
+    for (size_t i = 1; i < jumps.size(); ++i) {
+        int x = grid.cellX(jumps[i - 1]), y = grid.cellY(jumps[i - 1]);
+        int tx = grid.cellX(jumps[i]), ty = grid.cellY(jumps[i]);
+        int dx = sign(tx - x), dy = sign(ty - y);
+        while (x != tx || y != ty) {
+            x += dx;
+            y += dy;
+            path.push_back(grid.node(x, y));
+        }
+    }
+    return path;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include "graph.h"
+#include "pathfinding.h"
+#include <vector>
+
+// Jump Point Search over the uniform 8-connected grid built by createFourRoomGraph.
+// Works directly on gridMap / cols / rows with the same no-corner-cutting rule
+// and edge costs, and returns the full node-id path (every cell, like aStar).
+// Metrics::fill counts expanded jump points rather than grid cells.
+std::vector<int> jpsGrid(const Graph& g, int start, int goal, Metrics& m);
+std::vector<int> jpsGrid(const Graph& g, int start, int goal, Metrics& m, SearchContext& ctx);
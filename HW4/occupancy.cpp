@@ -0,0 +1,69 @@
+#include "occupancy.h"
+
+void OccupancyGrid::build(const Graph& g, const std::vector<sf::FloatRect>& walls) {
+    if (g.cellSize > 0.f) cells.build(walls, {0.f, 0.f}, g.cellSize, g.cols, g.rows);
+    else cells.build(walls, 20.f); // not a grid graph: cell ids are only meaningful to this class
+
+    occupancy.assign(cells.numCells(), 0);
+    for (int c = 0; c < cells.numCells(); ++c) occupancy[c] = cells.cellBegin(c) != cells.cellEnd(c);
+
+    bounds = sf::FloatRect(cells.getOrigin(), {cells.getCols() * cells.getCellSize(), cells.getRows() * cells.getCellSize()});
+    outsideWalls.clear();
+    for (int i = 0; i < (int)walls.size(); ++i) {
+        const sf::FloatRect& w = walls[i];
+        if (w.position.x < bounds.position.x || w.position.y < bounds.position.y ||
+            w.position.x + w.size.x > bounds.position.x + bounds.size.x ||
+            w.position.y + w.size.y > bounds.position.y + bounds.size.y) outsideWalls.push_back(i);
+    }
+
+    visibility.clear(); // stale for the new walls
+    visWords = 0;
+}
+
+bool OccupancyGrid::raycast(sf::Vector2f a, sf::Vector2f b) const {
+    if (!outsideWalls.empty() && !(bounds.contains(a) && bounds.contains(b))) {
+        for (int w : outsideWalls)
+            if (segmentCrossesRect(a, b, cells[w])) return false;
+    }
+
+    // A wall spanning several cells can get tested more than once; still far
+    // fewer tests than the whole wall list, and free cells cost one byte read
+    return cells.walkSegment(a, b, [&](int cx, int cy) {
+        int c = cy * cells.getCols() + cx;
+        if (!occupancy[c]) return true;
+        for (const int* w = cells.cellBegin(c); w != cells.cellEnd(c); ++w)
+            if (segmentCrossesRect(a, b, cells[*w])) return false;
+        return true;
+    });
+}
+
+int OccupancyGrid::cellAt(sf::Vector2f p) const {
+    sf::Vector2f o = cells.getOrigin();
+    float cs = cells.getCellSize();
+    if (p.x < o.x || p.y < o.y || p.x >= o.x + cells.getCols() * cs || p.y >= o.y + cells.getRows() * cs) return -1;
+    return cells.cellY(p.y) * cells.getCols() + cells.cellX(p.x);
+}
+
+sf::Vector2f OccupancyGrid::cellCenter(int cell) const {
+    float cs = cells.getCellSize();
+    int cx = cell % cells.getCols(), cy = cell / cells.getCols();
+    return cells.getOrigin() + sf::Vector2f((cx + 0.5f) * cs, (cy + 0.5f) * cs);
+}
+
+void OccupancyGrid::buildVisibility() {
+    int n = numCells();
+    visWords = (n + 63) / 64;
+    visibility.assign((size_t)n * visWords, 0);
+
+    // Symmetric, so each pair is cast once and written to both rows
+    for (int a = 0; a < n; ++a) {
+        std::uint64_t* rowA = visibility.data() + (size_t)a * visWords;
+        rowA[a >> 6] |= std::uint64_t(1) << (a & 63);
+        sf::Vector2f ca = cellCenter(a);
+        for (int b = a + 1; b < n; ++b) {
+            if (!raycast(ca, cellCenter(b))) continue;
+            rowA[b >> 6] |= std::uint64_t(1) << (b & 63);
+            visibility[(size_t)b * visWords + (a >> 6)] |= std::uint64_t(1) << (a & 63);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "graph.h"
+#include "wall_index.h"
+#include <cstdint>
+#include <vector>
+
+// The walls rasterized onto the navigation grid (same cols / rows / cellSize
+// as Graph::gridMap, so cell ids match gridMap indices). A cell is occupied
+// when a wall touches it; occupied cells keep the list of those walls.
+//
+// raycast() walks only the cells the segment crosses (Amanatides-Woo) and runs
+// the exact wall test on the occupied ones, so line of sight costs
+// O(cells traversed) and gives the same answer as testing every wall.
+//
+// buildVisibility() optionally precomputes, for every pair of cells, whether
+// their centres see each other: one bit per pair, O(1) to look up. That is a
+// property of cell centres, not of arbitrary points, so it is meant for coarse
+// queries (cover search, "could this cell see that one") rather than exact LOS.
+class OccupancyGrid {
+public:
+    OccupancyGrid() = default;
+    OccupancyGrid(const Graph& g, const std::vector<sf::FloatRect>& walls) { build(g, walls); }
+
+    void build(const Graph& g, const std::vector<sf::FloatRect>& walls);
+
+    // True when nothing blocks the segment a-b
+    bool raycast(sf::Vector2f a, sf::Vector2f b) const;
+
+    int cellAt(sf::Vector2f p) const; // -1 outside the grid
+    sf::Vector2f cellCenter(int cell) const;
+    bool occupied(int cell) const { return occupancy[cell] != 0; }
+
+    // --- Precomputed visibility ---
+    void buildVisibility(); // numCells()^2 bits, ~180 KB for the 40x30 four-room map
+    bool hasVisibility() const { return !visibility.empty(); }
+    bool cellsVisible(int a, int b) const { return (visibleFrom(a)[b >> 6] >> (b & 63)) & 1u; }
+    // Row of cell a: bit b set when the centres of a and b see each other
+    const std::uint64_t* visibleFrom(int a) const { return visibility.data() + (size_t)a * visWords; }
+    int visibilityWords() const { return visWords; }
+
+    int numCells() const { return cells.numCells(); }
+    const WallIndex& getWallIndex() const { return cells; }
+    const std::vector<sf::FloatRect>& getWalls() const { return cells.getWalls(); }
+
+private:
+    WallIndex cells; // per-cell wall lists on the graph's grid
+    std::vector<std::uint8_t> occupancy;
+    // Walls reaching outside the grid; only tested for segments that leave it
+    std::vector<int> outsideWalls;
+    sf::FloatRect bounds;
+    std::vector<std::uint64_t> visibility; // numCells() rows of visWords words
+    int visWords = 0;
+};
@@ -0,0 +1,70 @@
+#include "path_cache.h"
+#include <algorithm>
+
+PathCache::PathCache(size_t capacity) : maxEntries(std::max<size_t>(1, capacity)) {}
+
+void PathCache::sync(const Graph& g) {
+    if (g.revision == revision) return;
+    invalidate();
+    revision = g.revision;
+}
+
+void PathCache::invalidate() {
+    if (!lru.empty()) ++counters.invalidations;
+    lru.clear();
+    byPair.clear();
+    byGoal.clear();
+}
+
+bool PathCache::lookup(const Graph& g, int start, int goal, std::vector<int>& out) {
+    sync(g);
+
+    auto hit = byPair.find(key(start, goal));
+    if (hit != byPair.end()) {
+        lru.splice(lru.begin(), lru, hit->second);
+        out = hit->second->path;
+        ++counters.exactHits;
+        return true;
+    }
+
+    auto sameGoal = byGoal.find(goal);
+    if (sameGoal != byGoal.end()) {
+        for (EntryIt it : sameGoal->second) {
+            auto at = std::find(it->path.begin(), it->path.end(), start);
+            if (at == it->path.end()) continue;
+            out.assign(at, it->path.end());
+            lru.splice(lru.begin(), lru, it);
+            ++counters.subpathHits;
+            return true;
+        }
+    }
+
+    ++counters.misses;
+    return false;
+}
+
+void PathCache::store(const Graph& g, int start, int goal, const std::vector<int>& path) {
+    sync(g);
+    if (path.empty()) return;
+
+    auto hit = byPair.find(key(start, goal));
+    if (hit != byPair.end()) { // refreshed answer for a known pair
+        hit->second->path = path;
+        lru.splice(lru.begin(), lru, hit->second);
+        return;
+    }
+
+    if (lru.size() >= maxEntries) evictOldest();
+    lru.push_front({start, goal, path});
+    byPair[key(start, goal)] = lru.begin();
+    byGoal[goal].push_back(lru.begin());
+}
+
+void PathCache::evictOldest() {
+    EntryIt victim = std::prev(lru.end());
+    byPair.erase(key(victim->start, victim->goal));
+    std::vector<EntryIt>& bucket = byGoal[victim->goal];
+    bucket.erase(std::find(bucket.begin(), bucket.end(), victim));
+    if (bucket.empty()) byGoal.erase(victim->goal);
+    lru.pop_back();
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "graph.h"
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+struct PathCacheStats {
+    long exactHits = 0;   // same (start, goal) pair was cached
+    long subpathHits = 0; // start lies on a cached path to the same goal
+    long misses = 0;
+    long invalidations = 0;
+
+    long lookups() const { return exactHits + subpathHits + misses; }
+    double hitRate() const { return lookups() ? double(exactHits + subpathHits) / lookups() : 0.0; }
+};
+
+// LRU cache of node paths keyed on (start, goal). Every suffix of a shortest
+// path is itself a shortest path, so a cached A -> C also answers B -> C for
+// any B on it. Entries are tied to Graph::revision and dropped as soon as the
+// graph changes; invalidate() does the same on demand. Main thread only.
+class PathCache {
+public:
+    explicit PathCache(size_t capacity = 64);
+
+    // Copies the cached path into out (start..goal) and returns true on a hit
+    bool lookup(const Graph& g, int start, int goal, std::vector<int>& out);
+    // Empty paths are not stored, unreachable goals are cheap to rediscover
+    void store(const Graph& g, int start, int goal, const std::vector<int>& path);
+    void invalidate();
+
+    size_t size() const { return lru.size(); }
+    size_t capacity() const { return maxEntries; }
+    const PathCacheStats& stats() const { return counters; }
+    void resetStats() { counters = PathCacheStats{}; }
+
+private:
+    struct Entry {
+        int start;
+        int goal;
+        std::vector<int> path;
+    };
+    using EntryIt = std::list<Entry>::iterator;
+
+    size_t maxEntries;
+    unsigned revision = 0;
+    PathCacheStats counters;
+    std::list<Entry> lru; // most recently used first
+    std::unordered_map<long long, EntryIt> byPair;
+    std::unordered_map<int, std::vector<EntryIt>> byGoal; // for subpath hits
+
+    static long long key(int start, int goal) { return ((long long)start << 32) | (unsigned)goal; }
+    void sync(const Graph& g); // drops everything cached against an older revision
+    void evictOldest();
+};
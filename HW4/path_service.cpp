@@ -0,0 +1,91 @@
+#include "path_service.h"
+#include "jps.h"
+#include <algorithm>
+
+PathService::PathService(const Graph& g, unsigned workers) : graph(g) {
+    if (workers == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        workers = cores > 1 ? cores - 1 : 1; // leave a core for the render loop
+    }
+    for (unsigned i = 0; i < workers; ++i) threads.emplace_back(&PathService::workerLoop, this);
+}
+
+PathService::~PathService() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+        jobs.clear(); // nobody is going to drain them
+    }
+    workReady.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+int PathService::submit(const PathRequest& req) {
+    int ticket;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        ticket = nextTicket++;
+        jobs.push_back({ticket, req});
+    }
+    workReady.notify_one();
+    return ticket;
+}
+
+std::vector<int> PathService::submitBatch(const std::vector<PathRequest>& reqs) {
+    std::vector<int> tickets;
+    tickets.reserve(reqs.size());
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const PathRequest& req : reqs) {
+            tickets.push_back(nextTicket);
+            jobs.push_back({nextTicket++, req});
+        }
+    }
+    workReady.notify_all();
+    return tickets;
+}
+
+void PathService::drain(std::vector<PathReply>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mtx);
+    out.swap(done);
+}
+
+void PathService::waitIdle() {
+    std::unique_lock<std::mutex> lock(mtx);
+    idle.wait(lock, [this] { return jobs.empty() && running == 0; });
+}
+
+int PathService::inFlight() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return (int)jobs.size() + running;
+}
+
+void PathService::workerLoop() {
+    SearchContext ctx; // per-worker scratch, reused for every query it runs
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            workReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            ++running;
+        }
+
+        const PathRequest& r = job.req;
+        PathReply reply{job.ticket, r.tag, r.start, r.goal, {}, Metrics{}};
+        if (r.start >= 0 && r.goal >= 0 && r.start < graph.numVertices && r.goal < graph.numVertices) {
+            if (r.heuristic) reply.path = aStar(graph, r.start, r.goal, r.heuristic, reply.metrics, ctx);
+            else reply.path = jpsGrid(graph, r.start, r.goal, reply.metrics, ctx);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            done.push_back(std::move(reply));
+            --running;
+            if (jobs.empty() && running == 0) idle.notify_all();
+        }
+    }
+}
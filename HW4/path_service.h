@@ -0,0 +1,69 @@
+#pragma once
+#include "graph.h"
+#include "pathfinding.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+struct PathRequest {
+    int start = -1;
+    int goal = -1;
+    Heuristic heuristic; // empty: exact grid search (jpsGrid), no heuristic needed
+    int tag = 0;         // caller's id (agent index etc.), echoed back in the reply
+};
+
+struct PathReply {
+    int ticket;
+    int tag;
+    int start, goal;       // copied from the request
+    std::vector<int> path; // node ids, empty if unreachable
+    Metrics metrics;
+};
+
+// Runs path queries on a fixed pool of worker threads, each with its own
+// SearchContext. The graph must not change while the service is alive.
+// Finished queries go to a completion queue that the game loop drains once
+// per frame, so a burst of replans never blocks rendering.
+class PathService {
+public:
+    explicit PathService(const Graph& g, unsigned workers = 0); // 0: one per spare core
+    ~PathService();
+
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    // Returns a ticket that identifies the reply
+    int submit(const PathRequest& req);
+    // Same, but queues the whole batch under one lock and wakes every worker
+    std::vector<int> submitBatch(const std::vector<PathRequest>& reqs);
+
+    // Moves every finished reply into out (cleared first); never blocks on searches
+    void drain(std::vector<PathReply>& out);
+    // Blocks until nothing is queued or running (benchmarks / shutdown)
+    void waitIdle();
+
+    int inFlight() const;
+    unsigned numWorkers() const { return (unsigned)threads.size(); }
+
+private:
+    struct Job {
+        int ticket;
+        PathRequest req;
+    };
+
+    const Graph& graph;
+    std::vector<std::thread> threads;
+
+    mutable std::mutex mtx;
+    std::condition_variable workReady;
+    std::condition_variable idle;
+    std::deque<Job> jobs;
+    std::vector<PathReply> done;
+    int nextTicket = 1;
+    int running = 0;
+    bool stopping = false;
+
+    void workerLoop();
+};
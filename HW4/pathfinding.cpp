@@ -1,90 +1,106 @@
 #include "pathfinding.h"
-#include <queue>
-#include <set>
-#include <limits>
+#include "rng.h"
 #include <iostream>
-#include <random> // Added
+#include <algorithm>
+#include <cstdint>
 #include <cmath> // Added for std::sqrt, std::abs
 
-using pii = std::pair<float, int>; // dist, node
+SearchContext& threadSearchContext() {
+    thread_local SearchContext ctx;
+    return ctx;
+}
 
-std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m) {
+// Walks prev links back from goal; empty if goal was never reached
+static std::vector<int> reconstructPath(const SearchContext& ctx, int start, int goal) {
+    std::vector<int> path;
+    if (!ctx.seen(goal)) return path;
+    for (int at = goal; at != -1; at = ctx.parent(at)) path.push_back(at);
+    std::reverse(path.begin(), path.end());
+    return (path.front() == start) ? path : std::vector<int>{};
+}
+
+// Search bodies are templated over the adjacency layout (adj lists or CSR)
+template <class Adjacency>
+static std::vector<int> dijkstraImpl(const Graph& g, const Adjacency& adj, int start, int goal, Metrics& m, SearchContext& ctx) {
     auto t0 = std::chrono::high_resolution_clock::now();
-    std::vector<float> dist(g.numVertices, std::numeric_limits<float>::infinity());
-    std::vector<int> prev(g.numVertices, -1);
-    dist[start] = 0;
-    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq;
-    pq.push({0, start});
-    std::set<int> visited;
+    ctx.begin(g.numVertices);
+    ctx.relax(start, 0.f, -1);
+    ctx.open.push(start, 0.f); // one entry per vertex, decrease-key on relax
     m.max_fringe = 1;
     m.fill = 0;
 
-    while (!pq.empty()) {
-        auto [d, u] = pq.top(); pq.pop();
-        if (visited.count(u)) continue;
-        visited.insert(u);
+    while (!ctx.open.empty()) {
+        int u = ctx.open.pop();
+        ctx.close(u);
         m.fill++;
         if (u == goal) break;
 
-        for (auto [v, w] : g.adj[u]) {
-            if (d + w < dist[v]) {
-                dist[v] = d + w;
-                prev[v] = u;
-                pq.push({dist[v], v});
+        float du = ctx.g(u);
+        forEachEdge(adj, u, [&](int v, float w) {
+            if (ctx.closed(v)) return;
+            if (du + w < ctx.g(v)) {
+                ctx.relax(v, du + w, u);
+                ctx.open.push(v, du + w);
             }
-        }
-        m.max_fringe = std::max(m.max_fringe, (int)pq.size());
+        });
+        m.max_fringe = std::max(m.max_fringe, ctx.open.size());
     }
 
     auto t1 = std::chrono::high_resolution_clock::now();
     m.runtime_ms = std::chrono::duration<float, std::milli>(t1 - t0).count();
 
-    // Reconstruct path
-    std::vector<int> path;
-    for (int at = goal; at != -1; at = prev[at]) path.push_back(at);
-    std::reverse(path.begin(), path.end());
-    return (path.front() == start) ? path : std::vector<int>{};
+    return reconstructPath(ctx, start, goal);
 }
 
-std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m) {
+template <class Adjacency>
+static std::vector<int> aStarImpl(const Graph& g, const Adjacency& adj, int start, int goal, const Heuristic& h, Metrics& m, SearchContext& ctx) {
     auto t0 = std::chrono::high_resolution_clock::now();
-    std::vector<float> gscore(g.numVertices, std::numeric_limits<float>::infinity());
-    std::vector<float> fscore(g.numVertices, std::numeric_limits<float>::infinity());
-    std::vector<int> prev(g.numVertices, -1);
-    gscore[start] = 0;
-    fscore[start] = h(start, goal, g);
-    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq; // f, node
-    pq.push({fscore[start], start});
-    std::set<int> visited;
+    ctx.begin(g.numVertices);
+    ctx.relax(start, 0.f, -1);
+    ctx.open.push(start, h(start, goal, g)); // keyed on f, decrease-key on relax
     m.max_fringe = 1;
     m.fill = 0;
 
-    while (!pq.empty()) {
-        auto [f, u] = pq.top(); pq.pop();
-        if (visited.count(u)) continue;
-        visited.insert(u);
+    while (!ctx.open.empty()) {
+        int u = ctx.open.pop();
+        ctx.close(u);
         m.fill++;
         if (u == goal) break;
 
-        for (auto [v, w] : g.adj[u]) {
-            float tent_g = gscore[u] + w;
-            if (tent_g < gscore[v]) {
-                prev[v] = u;
-                gscore[v] = tent_g;
-                fscore[v] = tent_g + h(v, goal, g);
-                pq.push({fscore[v], v});
+        float gu = ctx.g(u);
+        forEachEdge(adj, u, [&](int v, float w) {
+            if (ctx.closed(v)) return;
+            float tent_g = gu + w;
+            if (tent_g < ctx.g(v)) {
+                ctx.relax(v, tent_g, u);
+                ctx.open.push(v, tent_g + h(v, goal, g));
             }
-        }
-        m.max_fringe = std::max(m.max_fringe, (int)pq.size());
+        });
+        m.max_fringe = std::max(m.max_fringe, ctx.open.size());
     }
 
     auto t1 = std::chrono::high_resolution_clock::now();
     m.runtime_ms = std::chrono::duration<float, std::milli>(t1 - t0).count();
 
-    std::vector<int> path;
-    for (int at = goal; at != -1; at = prev[at]) path.push_back(at);
-    std::reverse(path.begin(), path.end());
-    return (path.front() == start) ? path : std::vector<int>{};
+    return reconstructPath(ctx, start, goal);
+}
+
+std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m) {
+    return dijkstra(g, start, goal, m, threadSearchContext());
+}
+
+std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m) {
+    return aStar(g, start, goal, h, m, threadSearchContext());
+}
+
+std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m, SearchContext& ctx) {
+    if (g.isFinalized()) return dijkstraImpl(g, g.csr, start, goal, m, ctx);
+    return dijkstraImpl(g, g.adj, start, goal, m, ctx);
+}
+
+std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m, SearchContext& ctx) {
+    if (g.isFinalized()) return aStarImpl(g, g.csr, start, goal, h, m, ctx);
+    return aStarImpl(g, g.adj, start, goal, h, m, ctx);
 }
 
 float euclideanHeur(int u, int v, const Graph& g) {
@@ -118,10 +134,9 @@ void analyzeHeur(const Graph& g, Heuristic h, bool admissible) {
     int overCount = 0;
     float totalOver = 0.f;
     int samples = 100;
-    std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<int> dis(0, g.numVertices - 1);
+    Rng& rng = threadRng();
     for (int i = 0; i < samples; ++i) {
-        int s = dis(gen), goal = dis(gen);
+        int s = rng.below(g.numVertices), goal = rng.below(g.numVertices);
         Metrics m;
         auto path = dijkstra(g, s, goal, m); // true dist
         if (path.empty()) continue;
@@ -1,5 +1,6 @@
 #pragma once
 #include "graph.h"
+#include "search_context.h"
 #include <vector>
 #include <functional>
 #include <chrono>
@@ -15,5 +16,11 @@ using Heuristic = std::function<float(int, int, const Graph&)>;
 float euclideanHeur(int u, int v, const Graph& g);
 void initClusters(const Graph& g, int numClusters);
 
+// Searches reuse the caller's SearchContext; the overloads without one use a
+// thread_local context so repeated queries never reallocate scratch arrays.
+SearchContext& threadSearchContext();
+
 std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m);
-std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m);
\ No newline at end of file
+std::vector<int> dijkstra(const Graph& g, int start, int goal, Metrics& m, SearchContext& ctx);
+std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m);
+std::vector<int> aStar(const Graph& g, int start, int goal, Heuristic h, Metrics& m, SearchContext& ctx);
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include "indexed_heap.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Scratch space for graph searches, meant to be owned per thread or per agent.
+// The arrays stay allocated across queries; begin() invalidates them in O(1) by
+// bumping a generation counter instead of refilling them with infinity.
+class SearchContext {
+public:
+    IndexedHeap open;
+
+    // Prepares the context for a search over n vertices
+    void begin(int n) {
+        if ((int)gscore.size() != n) {
+            gscore.assign(n, 0.f);
+            prev.assign(n, -1);
+            seenStamp.assign(n, 0);
+            closedStamp.assign(n, 0);
+            open.reset(n);
+            generation = 1;
+            return;
+        }
+        open.clear();
+        if (++generation == 0) { // wrapped: stale stamps could alias, so wipe once
+            std::fill(seenStamp.begin(), seenStamp.end(), 0u);
+            std::fill(closedStamp.begin(), closedStamp.end(), 0u);
+            generation = 1;
+        }
+    }
+
+    bool seen(int v) const { return seenStamp[v] == generation; }
+    bool closed(int v) const { return closedStamp[v] == generation; }
+    void close(int v) { closedStamp[v] = generation; }
+
+    // g-value of v for the current search (infinity if not reached yet)
+    float g(int v) const { return seen(v) ? gscore[v] : std::numeric_limits<float>::infinity(); }
+    int parent(int v) const { return seen(v) ? prev[v] : -1; }
+
+    void relax(int v, float g, int parent) {
+        gscore[v] = g;
+        prev[v] = parent;
+        seenStamp[v] = generation;
+    }
+
+private:
+    std::vector<float> gscore;
+    std::vector<int> prev;
+    std::vector<std::uint32_t> seenStamp;
+    std::vector<std::uint32_t> closedStamp;
+    std::uint32_t generation = 0;
+};
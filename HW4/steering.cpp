@@ -12,53 +12,68 @@ float mapToRange(float rotation) {
 }
 
 float randomBinomial() {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_real_distribution<float> dis(0.f, 1.f);
-    return dis(gen) - dis(gen);
+    return threadRng().binomial();
 }
 
 float randomFloat(float a, float b) {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_real_distribution<float> dis(a, b);
-    return dis(gen);
+    return threadRng().range(a, b);
+}
+
+int FixedTimestep::advance(float frameTime) {
+    accumulator += frameTime;
+    int steps = 0;
+    while (accumulator >= dt && steps < maxSubsteps) {
+        accumulator -= dt;
+        steps++;
+    }
+    if (accumulator >= dt) accumulator = std::fmod(accumulator, dt);
+    return steps;
 }
 
 // --- Breadcrumb ---
+// Appends a filled octagon (8 triangles) around center to a Triangles array
+static void appendDot(sf::VertexArray &mesh, std::size_t &v, sf::Vector2f center, float radius, sf::Color col) {
+    static const sf::Vector2f octagon[8] = {{1.f, 0.f}, {0.7071068f, 0.7071068f}, {0.f, 1.f}, {-0.7071068f, 0.7071068f},
+                                            {-1.f, 0.f}, {-0.7071068f, -0.7071068f}, {0.f, -1.f}, {0.7071068f, -0.7071068f}};
+    for (int k = 0; k < 8; ++k) {
+        mesh[v++] = sf::Vertex{center, col};
+        mesh[v++] = sf::Vertex{center + octagon[k] * radius, col};
+        mesh[v++] = sf::Vertex{center + octagon[(k + 1) % 8] * radius, col};
+    }
+}
+
 Breadcrumb::Breadcrumb(int maxCrumbs_, int dropInterval_, sf::Color c)
-    : maxCrumbs(maxCrumbs_), dropInterval(dropInterval_), counter(0), color(c) {}
+    : ring(std::max(0, maxCrumbs_)), head(0), count(0), maxCrumbs(maxCrumbs_), dropInterval(dropInterval_),
+      counter(0), color(c), mesh(sf::PrimitiveType::Triangles) {}
 
 void Breadcrumb::update(const sf::Vector2f &pos) {
     if (++counter >= dropInterval) {
         counter = 0;
-        q.push(pos);
-        if ((int)q.size() > maxCrumbs) q.pop();
+        if (maxCrumbs <= 0) return;
+        if (count < maxCrumbs) ring[(head + count++) % maxCrumbs] = pos;
+        else { ring[head] = pos; head = (head + 1) % maxCrumbs; }
     }
 }
 
 void Breadcrumb::draw(sf::RenderWindow &win) {
-    std::queue<sf::Vector2f> temp = q;
+    if (count == 0) return;
+    mesh.resize(static_cast<std::size_t>(count) * 24);
     float alpha = 20.f; 
     // Calculate increment to reach ~255 at the head of the trail
-    float inc = 235.f / std::max(1, (int)q.size()); 
-    
-    while (!temp.empty()) {
-        sf::Vector2f p = temp.front(); temp.pop();
-        
-        sf::CircleShape dot(3.f); 
-        dot.setOrigin({1.5f, 1.5f});
-        dot.setPosition(p);
-        
+    float inc = 235.f / count;
+    std::size_t v = 0;
+    for (int i = 0; i < count; ++i) {
+        // Dots used to be radius-3 circles with origin (1.5, 1.5), keep them where they were
+        sf::Vector2f center = ring[(head + i) % maxCrumbs] + sf::Vector2f(1.5f, 1.5f);
         std::uint8_t a = static_cast<std::uint8_t>(std::min(255.f, alpha));
-        dot.setFillColor(sf::Color(color.r, color.g, color.b, a));
-        
-        win.draw(dot);
+        appendDot(mesh, v, center, 3.f, sf::Color(color.r, color.g, color.b, a));
         alpha += inc;
     }
+    win.draw(mesh);
 }
 
 void Breadcrumb::clear() {
-    std::queue<sf::Vector2f> empty;
-    std::swap(q, empty);
+    head = count = 0;
 }
 
 // --- Character ---
@@ -79,18 +94,19 @@ Character::Character()
     // Explicitly zero out velocity
     kinematic.velocity = {0.f, 0.f};
     kinematic.rotation = 0.f;
+    previous = kinematic;
 }
 
+// Collision correction within a tick, so previous is left alone
 void Character::setPosition(float x, float y) {
     kinematic.position = {x, y};
-    shape.setPosition(kinematic.position);
 }
 
 void Character::teleport(float x, float y) {
     kinematic.position = {x, y};
     kinematic.velocity = {0.f, 0.f};
     kinematic.rotation = 0.f;
-    shape.setPosition(kinematic.position);
+    previous = kinematic; // no blending across a reset
     breadcrumbs.clear();
     path.clear();
     isAttacking = false;
@@ -182,7 +198,7 @@ void Character::flee(sf::Vector2f targetPos, float dt) {
 void Character::wander(float dt) {
     if (isAttacking) return;
     // 1. Update the wander orientation (accumulate small random changes)
-    wanderOrientation += randomBinomial() * 3.0f * dt; // Adjusted jitter rate
+    wanderOrientation += rng.binomial() * 3.0f * dt; // Adjusted jitter rate
 
     // 2. Calculate the center of the wander circle in front of the agent
     sf::Vector2f circleCenter = kinematic.position;
@@ -228,6 +244,8 @@ void Character::stop() {
 }
 
 void Character::update(float dt, const Kinematic& /*target*/) {
+    previous = kinematic;
+
     // 0. Path Following
     if (!isAttacking && !path.empty() && currentWaypoint < (int)path.size()) {
         sf::Vector2f target = path[currentWaypoint];
@@ -267,12 +285,19 @@ void Character::update(float dt, const Kinematic& /*target*/) {
 
     // 2. Update Visuals
     breadcrumbs.update(kinematic.position);
-    
-    shape.setPosition(kinematic.position);
-    shape.setRotation(sf::degrees(kinematic.orientation * 180.f / PI));
 }
 
-void Character::draw(sf::RenderWindow &win) {
+Kinematic Character::renderPose(float alpha) const {
+    Kinematic pose = kinematic;
+    pose.position = previous.position + (kinematic.position - previous.position) * alpha;
+    pose.orientation = mapToRange(previous.orientation + mapToRange(kinematic.orientation - previous.orientation) * alpha);
+    return pose;
+}
+
+void Character::draw(sf::RenderWindow &win, float alpha) {
+    Kinematic pose = renderPose(alpha);
+    shape.setPosition(pose.position);
+    shape.setRotation(sf::degrees(pose.orientation * 180.f / PI));
     breadcrumbs.draw(win);
     win.draw(shape);
 }
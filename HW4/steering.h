@@ -1,9 +1,8 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <queue>
 #include <cmath>
-#include <random>
+#include "rng.h"
 
 const float PI = 3.14159265f;
 
@@ -30,12 +29,30 @@ struct SteeringOutput {
     SteeringOutput() : linear(0,0), angular(0) {}
 };
 
+// Fixed-step clock for the viewer: advance() turns the real frame time into a
+// number of dt ticks (capped at maxSubsteps, a longer backlog is dropped so a
+// hitch slows the game down instead of stalling it), alpha() is where the
+// rendered frame sits between the last two ticks.
+struct FixedTimestep {
+    float dt;
+    int maxSubsteps;
+    float accumulator = 0.f;
+
+    explicit FixedTimestep(float hz = 60.f, int maxSteps = 5) : dt(1.f / hz), maxSubsteps(maxSteps) {}
+    int advance(float frameTime);
+    float alpha() const { return accumulator / dt; }
+};
+
+// Ring buffer of the last maxCrumbs drops, drawn with a single vertex array
 class Breadcrumb {
+    std::vector<sf::Vector2f> ring; // fixed capacity maxCrumbs, oldest at head
+    int head;
+    int count;
     int maxCrumbs;
     int dropInterval;
     int counter;
     sf::Color color;
-    std::queue<sf::Vector2f> q;
+    sf::VertexArray mesh; // reused every draw, one octagon per crumb
 public:
     Breadcrumb(int maxCrumbs_ = 200, int dropInterval_ = 5, sf::Color c = sf::Color::White);
     void update(const sf::Vector2f& pos);
@@ -46,6 +63,7 @@ public:
 class Character {
 private:
     Kinematic kinematic;
+    Kinematic previous; // state before the last update(), for interpolated drawing
     sf::ConvexShape shape;
     Breadcrumb breadcrumbs;
     std::vector<sf::Vector2f> path;
@@ -56,6 +74,7 @@ private:
     float wanderRadius;      // Added for better wander
     bool isAttacking;
     float attackTimer;
+    Rng rng; // wander jitter and this agent's random decisions, seeded by World
 
 public:
     Character();
@@ -66,12 +85,15 @@ public:
     
     const Kinematic& getKinematic() const { return kinematic; }
     Kinematic& getKinematicRef() { return kinematic; } // Added mutable accessor
+    Rng& getRng() { return rng; }
     void setPath(const std::vector<sf::Vector2f>& p);
     void setMaxSpeed(float speed); // Added to control speed
     void setColor(sf::Color c); // Added to set color
     
     void update(float dt, const Kinematic& target);
-    void draw(sf::RenderWindow& win);
+    // alpha blends from the previous tick (0) to the current state (1)
+    Kinematic renderPose(float alpha) const;
+    void draw(sf::RenderWindow& win, float alpha = 1.f);
     
     bool isPathComplete() const; // Added helper
 
@@ -83,5 +105,6 @@ public:
 };
 
 float mapToRange(float rotation);
+// Draw from threadRng(), agents use their own Rng instead
 float randomBinomial();
 float randomFloat(float a, float b);
\ No newline at end of file
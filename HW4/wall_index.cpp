@@ -0,0 +1,119 @@
+#include "wall_index.h"
+
+// Walls are registered this far beyond their box, so a query that only
+// touches a wall edge lying on a cell border still finds it
+static const float PAD = 1.f;
+
+static bool lineSegmentsIntersect(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3, sf::Vector2f p4) {
+    float det = (p2.x - p1.x) * (p4.y - p3.y) - (p2.y - p1.y) * (p4.x - p3.x);
+    if (std::abs(det) < 0.001f) {
+        return false; // Parallel or collinear
+    }
+    float t = ((p3.x - p1.x) * (p4.y - p3.y) - (p3.y - p1.y) * (p4.x - p3.x)) / det;
+    float u = -((p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x)) / det;
+    return t >= 0 && t <= 1 && u >= 0 && u <= 1;
+}
+
+bool segmentCrossesRect(sf::Vector2f a, sf::Vector2f b, const sf::FloatRect& r) {
+    sf::Vector2f p1 = r.position;
+    sf::Vector2f p2 = {r.position.x + r.size.x, r.position.y};
+    sf::Vector2f p3 = {r.position.x + r.size.x, r.position.y + r.size.y};
+    sf::Vector2f p4 = {r.position.x, r.position.y + r.size.y};
+    return lineSegmentsIntersect(a, b, p1, p2) ||
+           lineSegmentsIntersect(a, b, p2, p3) ||
+           lineSegmentsIntersect(a, b, p3, p4) ||
+           lineSegmentsIntersect(a, b, p4, p1);
+}
+
+void WallIndex::build(const std::vector<sf::FloatRect>& w, float cs) {
+    if (w.empty()) {
+        build(w, {0.f, 0.f}, cs, 0, 0);
+        return;
+    }
+    float minX = w[0].position.x, minY = w[0].position.y;
+    float maxX = minX, maxY = minY;
+    for (const auto& r : w) {
+        minX = std::min(minX, r.position.x);
+        minY = std::min(minY, r.position.y);
+        maxX = std::max(maxX, r.position.x + r.size.x);
+        maxY = std::max(maxY, r.position.y + r.size.y);
+    }
+    sf::Vector2f o(minX - PAD, minY - PAD);
+    build(w, o, cs,
+          std::max(1, (int)std::ceil((maxX + PAD - o.x) / cs)),
+          std::max(1, (int)std::ceil((maxY + PAD - o.y) / cs)));
+}
+
+void WallIndex::build(const std::vector<sf::FloatRect>& w, sf::Vector2f o, float cs, int c, int r) {
+    walls = w;
+    origin = o;
+    cellSize = cs;
+    cols = c;
+    rows = r;
+    fillCells();
+}
+
+void WallIndex::fillCells() {
+    cellStart.assign(cols * rows + 1, 0);
+    cellWalls.clear();
+    if (cols == 0 || rows == 0) return;
+
+    // Count, prefix sum, then fill (same layout as a CSR graph)
+    auto forCells = [&](const sf::FloatRect& r, auto&& fn) {
+        int x0 = cellX(r.position.x - PAD), x1 = cellX(r.position.x + r.size.x + PAD);
+        int y0 = cellY(r.position.y - PAD), y1 = cellY(r.position.y + r.size.y + PAD);
+        for (int cy = y0; cy <= y1; ++cy)
+            for (int cx = x0; cx <= x1; ++cx) fn(cy * cols + cx);
+    };
+    for (const auto& r : walls) forCells(r, [&](int c) { cellStart[c + 1]++; });
+    for (int c = 0; c < cols * rows; ++c) cellStart[c + 1] += cellStart[c];
+
+    cellWalls.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < (int)walls.size(); ++i) forCells(walls[i], [&](int c) { cellWalls[fill[c]++] = i; });
+}
+
+int WallIndex::cellX(float x) const {
+    return std::clamp((int)std::floor((x - origin.x) / cellSize), 0, cols - 1);
+}
+
+int WallIndex::cellY(float y) const {
+    return std::clamp((int)std::floor((y - origin.y) / cellSize), 0, rows - 1);
+}
+
+void WallIndex::appendCell(int cx, int cy, std::vector<int>& out) const {
+    int c = cy * cols + cx;
+    out.insert(out.end(), cellBegin(c), cellEnd(c));
+}
+
+void WallIndex::finish(std::vector<int>& out) {
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void WallIndex::overlapping(const sf::FloatRect& box, std::vector<int>& out) const {
+    out.clear();
+    if (cols == 0) return;
+    float right = box.position.x + box.size.x, bottom = box.position.y + box.size.y;
+    if (right < origin.x || bottom < origin.y ||
+        box.position.x > origin.x + cols * cellSize || box.position.y > origin.y + rows * cellSize) return;
+
+    int x0 = cellX(box.position.x), x1 = cellX(right);
+    int y0 = cellY(box.position.y), y1 = cellY(bottom);
+    for (int cy = y0; cy <= y1; ++cy)
+        for (int cx = x0; cx <= x1; ++cx) appendCell(cx, cy, out);
+    finish(out);
+}
+
+void WallIndex::near(sf::Vector2f p, float radius, std::vector<int>& out) const {
+    overlapping(sf::FloatRect({p.x - radius, p.y - radius}, {2.f * radius, 2.f * radius}), out);
+}
+
+void WallIndex::alongSegment(sf::Vector2f a, sf::Vector2f b, std::vector<int>& out) const {
+    out.clear();
+    walkSegment(a, b, [&](int cx, int cy) {
+        appendCell(cx, cy, out);
+        return true;
+    });
+    finish(out);
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// True if segment a-b crosses one of the four edges of r (touching counts).
+// A segment entirely inside r does not cross it; this is the wall test the
+// line-of-sight code has always used.
+bool segmentCrossesRect(sf::Vector2f a, sf::Vector2f b, const sf::FloatRect& r);
+
+// Static uniform grid over the wall rectangles. Every wall is registered in
+// each cell its (slightly padded) box touches, so the queries below return a
+// superset of the walls that can matter: callers still run their exact test on
+// the candidates. Candidates come back as wall indices, sorted ascending and
+// without duplicates, so looping over them visits walls in the same order as
+// looping over the full vector would. Rebuild after the walls change.
+class WallIndex {
+public:
+    WallIndex() = default;
+    explicit WallIndex(const std::vector<sf::FloatRect>& walls, float cellSize = 40.f) { build(walls, cellSize); }
+
+    // Grid sized to the bounding box of the walls
+    void build(const std::vector<sf::FloatRect>& walls, float cellSize = 40.f);
+    // Grid with a given layout (e.g. matching Graph::gridMap); walls sticking
+    // out of it are registered in the border cells
+    void build(const std::vector<sf::FloatRect>& walls, sf::Vector2f origin, float cellSize, int cols, int rows);
+
+    // Candidates for walls overlapping box
+    void overlapping(const sf::FloatRect& box, std::vector<int>& out) const;
+    // Candidates for walls within radius of p
+    void near(sf::Vector2f p, float radius, std::vector<int>& out) const;
+    // Candidates for walls crossed by the segment a-b (Amanatides-Woo cell walk)
+    void alongSegment(sf::Vector2f a, sf::Vector2f b, std::vector<int>& out) const;
+
+    // Calls fn(cx, cy) for each cell the segment a-b passes through, in order
+    // from a, stopping early when fn returns false. Returns false if stopped.
+    template <class Fn>
+    bool walkSegment(sf::Vector2f a, sf::Vector2f b, Fn&& fn) const;
+
+    const std::vector<sf::FloatRect>& getWalls() const { return walls; }
+    const sf::FloatRect& operator[](int i) const { return walls[i]; }
+    int size() const { return (int)walls.size(); }
+
+    // --- Cell access ---
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    float getCellSize() const { return cellSize; }
+    sf::Vector2f getOrigin() const { return origin; }
+    int numCells() const { return cols * rows; }
+    int cellX(float x) const; // clamped into the grid
+    int cellY(float y) const;
+    // Walls registered in cell c: cellBegin(c) .. cellEnd(c)
+    const int* cellBegin(int c) const { return cellWalls.data() + cellStart[c]; }
+    const int* cellEnd(int c) const { return cellWalls.data() + cellStart[c + 1]; }
+
+private:
+    std::vector<sf::FloatRect> walls;
+    sf::Vector2f origin{0.f, 0.f};
+    float cellSize = 40.f;
+    int cols = 0, rows = 0;
+    // Counting-sort layout: walls of cell c are cellWalls[cellStart[c] .. cellStart[c+1])
+    std::vector<int> cellStart;
+    std::vector<int> cellWalls;
+
+    void fillCells();
+    void appendCell(int cx, int cy, std::vector<int>& out) const;
+    static void finish(std::vector<int>& out); // sort + unique
+};
+
+template <class Fn>
+bool WallIndex::walkSegment(sf::Vector2f a, sf::Vector2f b, Fn&& fn) const {
+    if (cols == 0) return true;
+
+    // Clip a + t*d, t in [0, 1], to the grid (Liang-Barsky)
+    sf::Vector2f d = b - a;
+    float t0 = 0.f, t1 = 1.f;
+    const float lo[2] = {origin.x, origin.y};
+    const float hi[2] = {origin.x + cols * cellSize, origin.y + rows * cellSize};
+    const float from[2] = {a.x, a.y};
+    const float dir[2] = {d.x, d.y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (dir[axis] == 0.f) {
+            if (from[axis] < lo[axis] || from[axis] > hi[axis]) return true;
+            continue;
+        }
+        float ta = (lo[axis] - from[axis]) / dir[axis];
+        float tb = (hi[axis] - from[axis]) / dir[axis];
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1) return true;
+    }
+
+    sf::Vector2f p0 = a + d * t0, p1 = a + d * t1;
+    int cx = cellX(p0.x), cy = cellY(p0.y);
+    int ex = cellX(p1.x), ey = cellY(p1.y);
+    int stepX = d.x > 0.f ? 1 : (d.x < 0.f ? -1 : 0);
+    int stepY = d.y > 0.f ? 1 : (d.y < 0.f ? -1 : 0);
+
+    // t (along a->b) at which the walk crosses the next vertical / horizontal cell border
+    const float inf = std::numeric_limits<float>::infinity();
+    float tMaxX = stepX ? (origin.x + (cx + (stepX > 0)) * cellSize - a.x) / d.x : inf;
+    float tMaxY = stepY ? (origin.y + (cy + (stepY > 0)) * cellSize - a.y) / d.y : inf;
+    float tDeltaX = stepX ? cellSize / std::abs(d.x) : inf;
+    float tDeltaY = stepY ? cellSize / std::abs(d.y) : inf;
+
+    int steps = std::abs(ex - cx) + std::abs(ey - cy);
+    if (!fn(cx, cy)) return false;
+    for (int i = 0; i < steps; ++i) {
+        if (tMaxX < tMaxY) { cx += stepX; tMaxX += tDeltaX; }
+        else { cy += stepY; tMaxY += tDeltaY; }
+        if (cx < 0 || cx >= cols || cy < 0 || cy >= rows) break;
+        if (!fn(cx, cy)) return false;
+    }
+    // In case rounding walked a corner the other way
+    if (cx != ex || cy != ey) return fn(ex, ey);
+    return true;
+}
@@ -0,0 +1,498 @@
+#include "world.h"
+#include "pathfinding.h"
+#include "jps.h"
+#include "dt_learner.h"
+#include <iostream>
+#include <optional>
+#include <cmath>
+#include <algorithm>
+
+void moveEnemyChase(Character& enemy, const sf::Vector2f& targetPos, const Graph& graph, const OccupancyGrid& occupancy, float dt);
+void moveEnemySearch(Character& enemy, const Graph& graph, float dt);
+
+// --- GEOMETRY HELPERS ---
+bool hasLineOfSight(sf::Vector2f start, sf::Vector2f end, const OccupancyGrid& occupancy) {
+    return occupancy.raycast(start, end);
+}
+
+sf::Vector2f findHidingSpot(const sf::Vector2f& seekerPos, const sf::Vector2f& threatPos, const CoverMap& cover) {
+    return cover.nearestHidden(seekerPos, threatPos);
+}
+
+bool isNearAnyWall(sf::Vector2f pos, const DistanceField& field, float threshold) {
+    // Check screen borders
+    if (pos.x < threshold || pos.x > WINDOW_WIDTH - threshold ||
+        pos.y < threshold || pos.y > WINDOW_HEIGHT - threshold) return true;
+
+    // Internal walls: one sample of the distance field
+    return field.sample(pos) < threshold;
+}
+
+// --- PHYSICS HELPER ---
+// Treats the agent as a circle: pushes it out along the field gradient by the
+// penetration depth and removes the velocity component going into the wall.
+// A few passes, since in a corner the first push only clears one of the walls.
+void resolveKinematicCollisions(Kinematic& k, const DistanceField& field) {
+    float r = 10.f;
+    for (int pass = 0; pass < 3; ++pass) {
+        float d = field.sample(k.position);
+        if (d >= r) return;
+
+        sf::Vector2f n = field.gradient(k.position);
+        float len = std::hypot(n.x, n.y);
+        if (len < 0.001f) return; // exactly between two walls, no way out to pick
+        n /= len;
+
+        k.position += n * (r - d);
+        float into = k.velocity.x * n.x + k.velocity.y * n.y;
+        if (into < 0.f) k.velocity -= n * into;
+    }
+}
+
+// Decision Tree for the PLAYER
+std::unique_ptr<DTNode> buildPlayerDT() {
+    auto wander = std::make_unique<DTAction>(ActionType::WANDER);
+    auto flee = std::make_unique<DTAction>(ActionType::FLEE_ENEMY);
+    auto seek_center = std::make_unique<DTAction>(ActionType::SEEK_CENTER);
+
+    // If near a wall, seek center. Otherwise, wander.
+    auto checkNearWall = std::make_unique<DTDecision>("isNearWall", std::move(seek_center), std::move(wander));
+
+    // Root: Enemy Near?
+    auto root = std::make_unique<DTDecision>("enemyNear", std::move(flee), std::move(checkNearWall));
+
+    return root;
+}
+
+// Behavior Tree for the ENEMY
+std::unique_ptr<BTNode> buildEnemyBT(DataRecorder& recorder) {
+    auto root = std::make_unique<BTSelector>();
+    
+    // --- 1. CHASE SEQUENCE ---
+    auto chaseSeq = std::make_unique<BTSequence>();
+    
+    // Condition: Can See Player
+    chaseSeq->addChild(std::make_unique<BTCondition>([](EnemyContext& ctx) {
+        return hasLineOfSight(ctx.enemy.getKinematic().position, ctx.player.position, ctx.occupancy);
+    }));
+    
+    // Action: Chase
+    chaseSeq->addChild(std::make_unique<BTAction>([&recorder](EnemyContext& ctx) {
+        ctx.danceTimer = 0.f; // Stop dancing if we see the player
+        
+        WorldState state;
+        state.canSeeEnemy = true; 
+        state.enemyNear = (std::hypot(ctx.player.position.x - ctx.enemy.getKinematic().position.x, ctx.player.position.y - ctx.enemy.getKinematic().position.y) < 200.f);
+        state.isNearWall = false; 
+        state.canHide = false;
+        recorder.record(state, ActionType::CHASE);
+
+        moveEnemyChase(ctx.enemy, ctx.player.position, ctx.graph, ctx.occupancy, ctx.dt);
+        return BTStatus::SUCCESS;
+    }));
+    
+    root->addChild(std::move(chaseSeq));
+    
+    // --- 2. DANCE SEQUENCE ---
+    auto danceSeq = std::make_unique<BTSequence>();
+
+    // Condition: Should Dance? (Active timer OR random chance)
+    danceSeq->addChild(std::make_unique<BTCondition>([](EnemyContext& ctx) {
+        if (ctx.danceTimer > 0.f) return true; // Already dancing
+        
+        // 0.5% chance per tick to start dancing if not already
+        if (ctx.rng.below(1000) < 5) {
+            ctx.danceTimer = 1.5f; // Dance for 1.5 seconds
+            return true;
+        }
+        return false;
+    }));
+
+    // Action: Dance (Spin)
+    danceSeq->addChild(std::make_unique<BTAction>([&recorder](EnemyContext& ctx) {
+        ctx.danceTimer -= ctx.dt;
+        
+        WorldState state;
+        state.canSeeEnemy = false; // Can't see player while dancing (simplified)
+        state.enemyNear = false;
+        state.isNearWall = false;
+        state.canHide = false;
+        recorder.record(state, ActionType::DANCE);
+        
+        // Spin behavior
+        Kinematic& k = ctx.enemy.getKinematicRef();
+        k.velocity = {0.f, 0.f}; // Stop moving
+        k.rotation = 15.f; // Fast spin
+        k.orientation += k.rotation * ctx.dt; // Apply manually since we might have stopped physics updates for velocity
+
+        // Record (optional, mapping to NONE or a specific state)
+        // recorder.record(..., ActionType::NONE); 
+        
+        return BTStatus::SUCCESS;
+    }));
+
+    root->addChild(std::move(danceSeq));
+
+    // --- 3. WANDER ACTION (Default) ---
+    root->addChild(std::make_unique<BTAction>([&recorder](EnemyContext& ctx) {
+        WorldState state;
+        state.canSeeEnemy = false; 
+        state.enemyNear = false;
+        state.isNearWall = false;
+        state.canHide = false;
+        recorder.record(state, ActionType::WANDER);
+
+        // Use the same wander logic as player, or graph wander
+        // Let's use Graph Wander (Search) for the enemy
+        moveEnemySearch(ctx.enemy, ctx.graph, ctx.dt);
+        
+        return BTStatus::SUCCESS;
+    }));
+    
+    return root;
+}
+
+// --- ASYNC PATH PLANNING ---
+// planPath() hands searches to the PathService; applyFinishedPaths() picks up the
+// results once per frame. One request per agent is tracked, newest wins.
+// Answers go through pathCache first, chase / wander keep asking for the same cells.
+PathService* pathService = nullptr; // global for simplicity, owned by the World (null: plan inline)
+PathCache pathCache(128);
+
+struct PendingPath {
+    Character* agent;
+    sf::Vector2f target;
+    int goalNode;
+    int ticket;
+};
+std::vector<PendingPath> pendingPaths;
+
+void applyPath(Character& chara, const Graph& graph, const std::vector<int>& pathIndices, sf::Vector2f target) {
+    if (!pathIndices.empty()) {
+        std::vector<sf::Vector2f> points;
+        for (int idx : pathIndices) points.push_back(graph.positions[idx]);
+        points.push_back(target);
+        chara.setPath(points);
+    } else {
+        chara.setPath({target});
+    }
+}
+
+bool isPathPending(const Character& chara) {
+    for (const PendingPath& p : pendingPaths)
+        if (p.agent == &chara) return true;
+    return false;
+}
+
+void applyFinishedPaths(const Graph& graph) {
+    if (!pathService) return;
+    static std::vector<PathReply> replies;
+    pathService->drain(replies);
+    for (const PathReply& r : replies) {
+        pathCache.store(graph, r.start, r.goal, r.path); // superseded or not, the path is still valid
+        for (size_t i = 0; i < pendingPaths.size(); ++i) {
+            if (pendingPaths[i].ticket != r.ticket) continue; // superseded replies are dropped
+            applyPath(*pendingPaths[i].agent, graph, r.path, pendingPaths[i].target);
+            pendingPaths.erase(pendingPaths.begin() + i);
+            break;
+        }
+    }
+}
+
+void planPath(Character& chara, const Graph& graph, sf::Vector2f target) {
+    sf::Vector2f pos = chara.getKinematic().position;
+    int startNode = graph.getNodeAt(pos.x, pos.y, 20.f);
+    int endNode = graph.getNodeAt(target.x, target.y, 20.f);
+    
+    if (startNode == -1 || endNode == -1) {
+        chara.setPath({target});
+        return;
+    }
+
+    static std::vector<int> cached;
+    if (pathCache.lookup(graph, startNode, endNode, cached)) {
+        for (size_t i = 0; i < pendingPaths.size(); ++i) {
+            if (pendingPaths[i].agent != &chara) continue;
+            pendingPaths.erase(pendingPaths.begin() + i); // answered already, drop the queued search
+            break;
+        }
+        applyPath(chara, graph, cached, target);
+        return;
+    }
+    if (!pathService) {
+        Metrics m;
+        std::vector<int> path = jpsGrid(graph, startNode, endNode, m);
+        pathCache.store(graph, startNode, endNode, path);
+        applyPath(chara, graph, path, target);
+        return;
+    }
+
+    for (PendingPath& p : pendingPaths) {
+        if (p.agent != &chara) continue;
+        p.target = target;
+        if (p.goalNode != endNode) { // new destination: the queued search is stale
+            p.goalNode = endNode;
+            p.ticket = pathService->submit({startNode, endNode, {}, 0});
+        }
+        return;
+    }
+    pendingPaths.push_back({&chara, target, endNode, pathService->submit({startNode, endNode, {}, 0})});
+}
+
+void moveEnemyChase(Character& enemy, const sf::Vector2f& targetPos, const Graph& graph, const OccupancyGrid& occupancy, float dt) {
+    if (hasLineOfSight(enemy.getKinematic().position, targetPos, occupancy)) {
+        enemy.setPath({});
+        enemy.seek(targetPos, dt);
+    } else {
+        if (enemy.isPathComplete() && !isPathPending(enemy)) {
+             planPath(enemy, graph, targetPos);
+        }
+    }
+}
+
+void moveEnemySearch(Character& enemy, const Graph& graph, float dt) {
+    (void)dt;
+    if (enemy.isPathComplete() && !isPathPending(enemy)) {
+        if (graph.numVertices > 0) {
+             int r = enemy.getRng().below(graph.numVertices);
+             planPath(enemy, graph, graph.positions[r]);
+        }
+    }
+}
+
+// --- WORLD ---
+World::World(DataRecorder& rec, bool asyncPaths, bool verboseLog)
+    : recorder(rec), graph(createFourRoomGraph(walls)), occupancy(graph, walls), coverMap(occupancy), enemyTrail(150, 5, sf::Color::Red), verbose(verboseLog) {
+    hpa.build(graph);
+    if (asyncPaths) paths = std::make_unique<PathService>(graph);
+    pathService = paths.get();
+
+    enemy.setColor(sf::Color::Red);
+    playerDT = buildPlayerDT();
+    playerTable = DecisionTable::compile(*playerDT);
+    enemyBT = buildEnemyBT(recorder);
+    seed(((std::uint64_t)std::random_device{}() << 32) | std::random_device{}());
+    reset();
+}
+
+void World::seed(std::uint64_t s) {
+    chara.getRng().seed(s, 1);
+    enemy.getRng().seed(s, 2);
+}
+
+World::~World() {
+    pendingPaths.clear(); // they point at our characters
+    pathService = nullptr;
+}
+
+void World::reset() {
+    chara.teleport(AGENT_START_POS.x, AGENT_START_POS.y);
+    enemy.teleport(ENEMY_START_POS.x, ENEMY_START_POS.y);
+    pendingPaths.clear(); // planned from the old positions
+    mode = WARMUP;
+    stateTimer = 0.f;
+    if (verbose) std::cout << "Player is AI-controlled." << std::endl;
+}
+
+bool World::learnEnemyDT(const std::string& csvFile) {
+    std::cout << "Learning ENEMY DT from data..." << std::endl;
+    enemyDT = learnDT(csvFile);
+    if (!enemyDT) return false;
+    enemyTable = DecisionTable::compile(*enemyDT);
+    std::cout << "--- Learned Decision Tree ---" << std::endl;
+    enemyDT->print();
+    std::cout << "-----------------------------" << std::endl;
+    return true;
+}
+
+void World::planPlayerPath(sf::Vector2f target) {
+    int startNode = graph.getNodeAt(chara.getKinematic().position.x, chara.getKinematic().position.y, 20.f);
+    int endNode = graph.getNodeAt(target.x, target.y, 20.f);
+    
+    if (startNode != -1 && endNode != -1) {
+        planPath(chara, graph, target);
+    } else {
+        chara.seek(target, 0.016f); 
+    }
+}
+
+bool World::step(float dt) {
+    // Paths the workers finished since last step
+    applyFinishedPaths(graph);
+
+    // --- 1. GAME LOGIC & PLAYER AI ---
+    if (mode == WARMUP) {
+        stateTimer += dt;
+        if (stateTimer > 1.0f) {
+            mode = ACTING;
+            stateTimer = 0.f;
+            if (verbose) std::cout << "--- PLAYER AI ACTIVE ---" << std::endl;
+        }
+    }
+    else {
+        float dEnemy = std::hypot(chara.getKinematic().position.x - enemy.getKinematic().position.x, 
+                                  chara.getKinematic().position.y - enemy.getKinematic().position.y);
+
+        // *** GAME OVER CHECK ***
+        if (dEnemy < CATCH_DIST) {
+            if (verbose) std::cout << ">>> CAUGHT! Resetting positions... <<<" << std::endl;
+            reset();
+            return true;
+        }
+
+        if (mode == ACTING) {
+            WorldState state;
+            state.canSeeEnemy = hasLineOfSight(chara.getKinematic().position, enemy.getKinematic().position, occupancy);
+            state.enemyNear = (dEnemy < THREAT_DIST) && state.canSeeEnemy;
+            
+            sf::Vector2f hidingSpot = findHidingSpot(chara.getKinematic().position, enemy.getKinematic().position, coverMap);
+            state.canHide = (hidingSpot.x != -1.f);
+            
+            state.isNearWall = isNearAnyWall(chara.getKinematic().position, graph.distanceField, WALL_PROXIMITY);
+
+            // Make decisions for the player character
+            ActionType action = playerTable.decide(state);
+            
+            // Adjust speed based on threat
+            if (state.enemyNear) {
+                chara.setMaxSpeed(FLEE_SPEED);
+            } else {
+                chara.setMaxSpeed(NORMAL_SPEED);
+            }
+
+            pathUpdateTimer -= dt;
+            switch(action) {
+                case ActionType::FLEE_ENEMY:
+                    chara.setPath({}); // Clear any path and flee directly
+                    chara.flee(enemy.getKinematic().position, dt);
+                    break;
+                case ActionType::SEEK_CENTER: // Maps to "Avoid Wall" in the DT
+                    {
+                        // Find closest wall point to steer away from
+                        sf::Vector2f charPos = chara.getKinematic().position;
+                        sf::Vector2f repulsionVector(0.f, 0.f);
+                        bool foundWall = false;
+
+                        // Check borders
+                        if (charPos.x < WALL_PROXIMITY) { repulsionVector.x += 1.f; foundWall = true; }
+                        if (charPos.x > WINDOW_WIDTH - WALL_PROXIMITY) { repulsionVector.x -= 1.f; foundWall = true; }
+                        if (charPos.y < WALL_PROXIMITY) { repulsionVector.y += 1.f; foundWall = true; }
+                        if (charPos.y > WINDOW_HEIGHT - WALL_PROXIMITY) { repulsionVector.y -= 1.f; foundWall = true; }
+
+                        // Internal walls: the distance field gradient points away from the nearest one
+                        float wallDist = graph.distanceField.sample(charPos);
+                        if (wallDist < WALL_PROXIMITY && wallDist > 0.03f) {
+                            sf::Vector2f away = graph.distanceField.gradient(charPos);
+                            float len = std::hypot(away.x, away.y);
+                            if (len > 0.001f) {
+                                repulsionVector += away / len;
+                                foundWall = true;
+                            }
+                        }
+
+                        if (foundWall) {
+                            // normalize repulsion
+                            float len = std::hypot(repulsionVector.x, repulsionVector.y);
+                            if (len > 0.001f) {
+                                repulsionVector /= len;
+                            } else {
+                                // Forces cancelled out (e.g. doorway or narrow hall)
+                                // Break deadlock by moving forward or random
+                                if (chara.getKinematic().getSpeed() > 10.f) {
+                                    repulsionVector = chara.getKinematic().velocity / chara.getKinematic().getSpeed();
+                                } else {
+                                    // Totally stuck, pick random
+                                    float angle = (float)chara.getRng().below(360) * 3.14159f / 180.f;
+                                    repulsionVector = sf::Vector2f(std::cos(angle), std::sin(angle));
+                                }
+                            }
+
+                            // Steer in the direction of the repulsion vector
+                            // Increased distance to 100.f for less dramatic bounce
+                            sf::Vector2f target = charPos + repulsionVector * 100.f;
+                            chara.setPath({});
+                            chara.seek(target, dt);
+                        } else {
+                            // Fallback
+                            chara.wander(dt);
+                        }
+                    }
+                    break;
+                case ActionType::ATTACK:
+                    chara.setPath({});
+                    chara.attack(enemy.getKinematic().position, dt);
+                    break;
+                case ActionType::HIDE:
+                    if (state.canHide) {
+                         planPlayerPath(hidingSpot);
+                    } else {
+                         chara.flee(enemy.getKinematic().position, dt);
+                    }
+                    break;
+                case ActionType::WANDER:
+                    // Graph-Based Wander: Pick a random node and pathfind
+                    // This avoids local optima (getting stuck in corners/bouncing)
+                    if (chara.isPathComplete() && !isPathPending(chara)) {
+                        if (graph.numVertices > 0) {
+                            // Pick a random target node that isn't the current one
+                            int r = chara.getRng().below(graph.numVertices);
+                            sf::Vector2f target = graph.positions[r];
+                            
+                            // Plan path using A*
+                            planPlayerPath(target);
+                        }
+                    }
+                    // If path exists, Character::update automatically follows it.
+                    break;
+                default: 
+                    chara.stop();
+                    break;
+            }
+        }
+    }
+
+    // --- 2. PLAYER PHYSICS ---
+    Kinematic dummy; // Dummy target, not used by player update logic
+    chara.update(dt, dummy);
+    
+    Kinematic kChar = chara.getKinematic();
+    resolveKinematicCollisions(kChar, graph.distanceField);
+    chara.setPosition(kChar.position.x, kChar.position.y);
+
+    // --- 3. ENEMY INTELLIGENCE (Behavior Tree) ---
+    if (mode != WARMUP) {
+        if (!enemyTable.empty()) {
+             WorldState state;
+             state.canSeeEnemy = hasLineOfSight(enemy.getKinematic().position, chara.getKinematic().position, occupancy);
+             state.enemyNear = false; state.isNearWall = false; state.canHide = false;
+
+             ActionType act = enemyTable.decide(state);
+             if (act == ActionType::CHASE) {
+                 moveEnemyChase(enemy, chara.getKinematic().position, graph, occupancy, dt);
+             } else if (act == ActionType::DANCE) {
+                 // Replicate Dance spin behavior
+                 Kinematic& k = enemy.getKinematicRef();
+                 k.velocity = {0.f, 0.f}; 
+                 k.rotation = 15.f; 
+                 k.orientation += k.rotation * dt;
+             } else {
+                 moveEnemySearch(enemy, graph, dt);
+             }
+        } else {
+            // Execute Behavior Tree
+            EnemyContext ctx { enemy, chara.getKinematic(), occupancy, graph, dt, enemyDanceTimer, enemy.getRng() };
+            enemyBT->tick(ctx);
+        }
+
+        Kinematic dummy;
+        enemy.update(dt, dummy);
+        
+        Kinematic& kEnemy = enemy.getKinematicRef();
+        resolveKinematicCollisions(kEnemy, graph.distanceField);
+        enemy.setPosition(kEnemy.position.x, kEnemy.position.y);
+
+        enemyTrail.update(kEnemy.position);
+    }
+
+    return false;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "graph.h"
+#include "hpa.h"
+#include "path_cache.h"
+#include "path_service.h"
+#include "steering.h"
+#include "ai.h"
+#include "bt.h"
+#include "recorder.h"
+#include "occupancy.h"
+#include "cover_map.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// --- CONSTANTS ---
+const sf::Vector2f AGENT_START_POS(200.f, 150.f);
+const sf::Vector2f ENEMY_START_POS(600.f, 450.f);
+const sf::Vector2f CENTER_SCREEN(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f);
+
+const float THREAT_DIST = 200.0f;
+const float WALL_PROXIMITY = 25.0f; // Further decreased for less aggressive wall avoidance
+const float NORMAL_SPEED = 150.f;
+const float FLEE_SPEED = 250.f;
+const float CATCH_DIST = 30.f;
+
+// --- GEOMETRY HELPERS ---
+// Line of sight goes through the OccupancyGrid, proximity and collisions
+// through the Graph's DistanceField, so none of them loop over all walls
+bool hasLineOfSight(sf::Vector2f start, sf::Vector2f end, const OccupancyGrid& occupancy);
+// Nearest precomputed cover point the threat cannot see, (-1, -1) if none
+sf::Vector2f findHidingSpot(const sf::Vector2f& seekerPos, const sf::Vector2f& threatPos, const CoverMap& cover);
+bool isNearAnyWall(sf::Vector2f pos, const DistanceField& field, float threshold);
+void resolveKinematicCollisions(Kinematic& k, const DistanceField& field);
+
+extern PathCache pathCache; // shared by every path request, see planPath() in world.cpp
+
+// The pursuit / evasion simulation with no rendering or window in it: the
+// player runs its decision tree, the enemy its behavior tree (or the learned
+// DT), both move and collide with the walls. step() is driven either by the
+// windowed viewer at frame rate or by the headless runner as fast as possible.
+// One World per process (path planning state is global).
+class World {
+public:
+    // asyncPaths: plan on PathService workers (viewer); false plans inline, so a
+    // seeded run does not depend on thread timing
+    explicit World(DataRecorder& recorder, bool asyncPaths = true, bool verbose = true);
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    void reset(); // start positions, warm-up phase
+    // Reseeds both agents' generators (separate streams of the same seed). With
+    // synchronous paths the whole run then replays exactly; otherwise random.
+    void seed(std::uint64_t s);
+    // Advances everything by dt; true when the player got caught (already reset)
+    bool step(float dt);
+    bool learnEnemyDT(const std::string& csvFile);
+
+    const std::vector<sf::FloatRect>& getWalls() const { return walls; }
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
+    const Graph& getGraph() const { return graph; }
+    HPAGraph& getHPA() { return hpa; }
+    Character& getPlayer() { return chara; }
+    Character& getEnemy() { return enemy; }
+    Breadcrumb& getEnemyTrail() { return enemyTrail; }
+
+private:
+    DataRecorder& recorder;
+
+    // --- ENVIRONMENT ---
+    std::vector<sf::FloatRect> walls; // before graph, which fills it
+    Graph graph;
+    OccupancyGrid occupancy; // after graph: walls on its grid, for line of sight
+    CoverMap coverMap;       // hiding spots, built from occupancy
+    HPAGraph hpa; // rebuildArea() it if walls ever change at runtime (and graph.markChanged() for pathCache)
+    std::unique_ptr<PathService> paths;
+
+    // --- ENTITIES ---
+    Character chara; // This is the player
+    Character enemy; // This is the monster
+    Breadcrumb enemyTrail;
+
+    // --- AI STATE ---
+    std::unique_ptr<DTNode> playerDT;
+    std::unique_ptr<BTNode> enemyBT;
+    std::unique_ptr<DTNode> enemyDT;
+    // Compiled copies of the trees above, what step() actually evaluates
+    DecisionTable playerTable;
+    DecisionTable enemyTable;
+
+    enum Mode { WARMUP, ACTING };
+    Mode mode = WARMUP;
+    float stateTimer = 0.f;
+    float pathUpdateTimer = 0.f;
+    float enemyDanceTimer = 0.f; // Timer for the dance behavior
+    bool verbose;
+
+    void planPlayerPath(sf::Vector2f target);
+};